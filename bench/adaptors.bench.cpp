@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <ranges>
+
+#include <zzz/adaptors.hpp>
+#include <zzz/container.hpp>
+#include <zzz/coro.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+constexpr auto element_count = 1'000'000;
+
+auto naturals() -> zzz::Generator<int>
+{
+    for (auto i = 0;; ++i) {
+        co_yield i;
+    }
+}
+
+// One coroutine per stage, the way pipelines are written without adaptors.
+
+auto odd_stage(zzz::Generator<int> source) -> zzz::Generator<int>
+{
+    for (auto x : source) {
+        if (x % 2 != 0) { co_yield x; }
+    }
+}
+
+auto square_stage(zzz::Generator<int> source) -> zzz::Generator<int>
+{
+    for (auto x : source) {
+        co_yield x * x;
+    }
+}
+
+auto take_stage(zzz::Generator<int> source, int count) -> zzz::Generator<int>
+{
+    if (count == 0) co_return;
+    for (auto x : source) {
+        co_yield x;
+        if (--count == 0) co_return;
+    }
+}
+
+constexpr auto is_odd = [](int x) { return x % 2 != 0; };
+
+constexpr auto square = [](int x) { return x * x; };
+
+}  // namespace
+
+BENCH(adaptors)
+{
+    zzz::bench::measure(
+        "chained coroutines",
+        [] {
+            auto sum = 0U;
+            auto const pipeline =
+                take_stage(square_stage(odd_stage(naturals())), element_count);
+            for (auto x : pipeline) {
+                sum += static_cast<unsigned>(x);
+            }
+            zzz::bench::do_not_optimize(sum);
+        },
+        element_count);
+
+    zzz::bench::measure(
+        "zzz adaptors",
+        [] {
+            auto const sum = naturals() | zzz::filter(is_odd) | zzz::map(square) |
+                             zzz::take(element_count) |
+                             zzz::reduce([](unsigned a, int b) { return a + b; }, 0U);
+            zzz::bench::do_not_optimize(sum);
+        },
+        element_count);
+
+    zzz::bench::measure(
+        "std::views",
+        [] {
+            auto sum = 0U;
+            for (auto x : naturals() | std::views::filter(is_odd) |
+                              std::views::transform(square) |
+                              std::views::take(element_count)) {
+                sum += static_cast<unsigned>(x);
+            }
+            zzz::bench::do_not_optimize(sum);
+        },
+        element_count);
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <zzz/async_generator.hpp>
+#include <zzz/coro.hpp>
+#include <zzz/task.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+constexpr auto record_count = std::size_t{1'000'000};
+
+auto records() -> std::vector<int>
+{
+    auto result = std::vector<int>(record_count);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+}
+
+auto one_by_one(std::vector<int>& x) -> zzz::AsyncGenerator<int>
+{
+    for (auto& value : x) {
+        co_yield value;
+    }
+}
+
+auto batched(std::vector<int>& x, std::size_t batch_size) -> zzz::AsyncGenerator<int>
+{
+    for (auto i = std::size_t{0}; i < x.size(); i += batch_size) {
+        co_yield std::span{x}.subspan(i, std::min(batch_size, x.size() - i));
+    }
+}
+
+auto sync_one_by_one(std::vector<int>& x) -> zzz::Generator<int>
+{
+    for (auto& value : x) {
+        co_yield value;
+    }
+}
+
+auto sum(zzz::AsyncGenerator<int> gen) -> zzz::Task<long>
+{
+    auto result = 0L;
+    for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+        result += *it;
+    }
+    co_return result;
+}
+
+auto sum_batches(zzz::AsyncGenerator<int> gen) -> zzz::Task<long>
+{
+    auto result = 0L;
+    for (auto batch = co_await gen.next(); !batch.empty();
+         batch = co_await gen.next()) {
+        for (auto value : batch) {
+            result += value;
+        }
+    }
+    co_return result;
+}
+
+}  // namespace
+
+BENCH(async_generator)
+{
+    auto x = records();
+    zzz::bench::measure(
+        "Generator, one by one",
+        [&] {
+            auto result = 0L;
+            for (auto value : sync_one_by_one(x)) {
+                result += value;
+            }
+            zzz::bench::do_not_optimize(result);
+        },
+        record_count);
+    zzz::bench::measure(
+        "AsyncGenerator, one by one",
+        [&] { zzz::bench::do_not_optimize(zzz::sync_wait(sum(one_by_one(x)))); },
+        record_count);
+    for (auto batch_size : {16, 256, 4096}) {
+        auto const suffix = std::to_string(batch_size);
+        zzz::bench::measure(
+            "AsyncGenerator, iterate batches of " + suffix,
+            [&] {
+                auto gen = batched(x, batch_size);
+                auto const result = zzz::sync_wait(sum(std::move(gen)));
+                zzz::bench::do_not_optimize(result);
+            },
+            record_count);
+        zzz::bench::measure(
+            "AsyncGenerator, next() batches of " + suffix,
+            [&] {
+                auto gen = batched(x, batch_size);
+                auto const result = zzz::sync_wait(sum_batches(std::move(gen)));
+                zzz::bench::do_not_optimize(result);
+            },
+            record_count);
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Small benchmarking harness, in the spirit of zzz/test.hpp.
+ * @details
+ * BENCH(unique_id)
+ * {
+ *     zzz::bench::measure("label", [&] { ... }, items_per_iteration);
+ * }
+ */
+
+namespace zzz::bench {
+
+/** Represents a benchmark case.
+ *  @details Holds a benchmark function and its name.
+ */
+struct BenchCase {
+    std::string name;
+    std::function<void()> bench_func;
+};
+
+/** Returns a mutable list of registered benchmarks.
+ *  @return Reference to the static vector of benchmarks.
+ */
+[[nodiscard]] inline auto get_bench_cases() -> std::vector<BenchCase>&
+{
+    static std::vector<BenchCase> benches;
+    return benches;
+}
+
+/** Prevent the optimizer from discarding the computation of \p x. */
+template <typename T>
+void do_not_optimize(T const& x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(x) : "memory");
+#else
+    static auto volatile sink = static_cast<void const*>(nullptr);
+    sink = static_cast<void const*>(&x);
+#endif
+}
+
+/** Time \p fn, repeating it until at least \p min_time has elapsed.
+ *  @details Prints the mean time per call, and the throughput if \p items, the
+ *  number of items processed by one call, is non-zero.
+ *  @return Mean nanoseconds per call.
+ */
+template <typename Fn>
+auto measure(std::string_view label,
+             Fn&& fn,
+             std::size_t items = 0,
+             std::chrono::milliseconds min_time = std::chrono::milliseconds{250})
+    -> double
+{
+    using Clock = std::chrono::steady_clock;
+
+    fn();  // Warm up caches and lazily allocated state.
+
+    auto iterations = std::size_t{0};
+    auto const start = Clock::now();
+    auto elapsed = Clock::duration{};
+    do {
+        fn();
+        ++iterations;
+        elapsed = Clock::now() - start;
+    } while (elapsed < min_time);
+
+    auto const ns =
+        std::chrono::duration<double, std::nano>{elapsed}.count() / iterations;
+
+    std::cout << "  " << std::left << std::setw(48) << label << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << ns
+              << " ns/iter";
+    if (items != 0) {
+        std::cout << std::setw(12) << std::setprecision(2) << (items / ns) * 1'000.
+                  << " M items/s";
+    }
+    std::cout << '\n';
+    return ns;
+}
+
+/** Runs all registered benchmarks whose name contains \p filter. */
+inline void run_benches(std::string_view filter = "")
+{
+    for (auto const& bench : get_bench_cases()) {
+        if (bench.name.find(filter) == std::string::npos) { continue; }
+        std::cout << bench.name << '\n';
+        bench.bench_func();
+    }
+}
+
+}  // namespace zzz::bench
+
+/** Macro to register a benchmark case.
+ *  @details The macro declares the benchmark function, registers it, and then
+ *  defines it.
+ */
+#define BENCH(name)                                                                \
+    static void bench_##name();                                                    \
+    struct bench_##name##_registrar {                                              \
+        bench_##name##_registrar()                                                 \
+        {                                                                          \
+            zzz::bench::get_bench_cases().push_back({"bench_" #name, bench_##name}); \
+        }                                                                          \
+    } bench_##name##_registrar_instance;                                           \
+    static void bench_##name()
+
+#ifdef BENCH_MAIN
+
+/** Main entry point to run benchmarks.
+ *  @details An optional first argument filters benchmarks by name.
+ */
+auto main(int argc, char** argv) -> int
+{
+    zzz::bench::run_benches(argc > 1 ? argv[1] : "");
+    return 0;
+}
+
+#endif  // BENCH_MAIN
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zzz/bounded_queue.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+constexpr auto item_count = 1'000'000;
+constexpr auto round_trips = 10'000;
+constexpr auto batch_size = std::size_t{64};
+
+/// What the queues replace: a std::deque behind a mutex.
+template <typename T>
+class MutexQueue {
+   public:
+    explicit MutexQueue(std::size_t) {}
+
+    auto try_push(T value) -> bool
+    {
+        auto const lock = std::lock_guard{mutex_};
+        values_.push_back(std::move(value));
+        return true;
+    }
+
+    auto try_push_batch(std::span<T> values) -> std::size_t
+    {
+        auto const lock = std::lock_guard{mutex_};
+        values_.insert(values_.end(), values.begin(), values.end());
+        return values.size();
+    }
+
+    auto try_pop() -> std::optional<T>
+    {
+        auto const lock = std::lock_guard{mutex_};
+        if (values_.empty()) { return std::nullopt; }
+        auto result = std::optional<T>{std::move(values_.front())};
+        values_.pop_front();
+        return result;
+    }
+
+    auto try_pop_batch(std::span<T> out) -> std::size_t
+    {
+        auto const lock = std::lock_guard{mutex_};
+        auto const count = std::min(out.size(), values_.size());
+        std::move(values_.begin(), values_.begin() + count, out.begin());
+        values_.erase(values_.begin(), values_.begin() + count);
+        return count;
+    }
+
+   private:
+    std::mutex mutex_;
+    std::deque<T> values_;
+};
+
+/// Push \p count values, one at a time or in batches, yielding while it is full.
+template <typename Queue>
+void produce(Queue& queue, int count, bool batch)
+{
+    auto values = std::array<int, batch_size>{};
+    for (auto i = 0; i < count;) {
+        auto pushed = std::size_t{0};
+        if (batch) {
+            auto const size = std::min<std::size_t>(batch_size, count - i);
+            std::fill_n(values.begin(), size, i);
+            pushed = queue.try_push_batch(std::span{values.data(), size});
+        }
+        else {
+            pushed = queue.try_push(i) ? 1 : 0;
+        }
+        if (pushed == 0) { std::this_thread::yield(); }
+        i += static_cast<int>(pushed);
+    }
+}
+
+/// Pop values until \p popped reaches \p total, yielding while it is empty.
+template <typename Queue>
+void consume(Queue& queue, std::atomic<int>& popped, int total, bool batch)
+{
+    auto values = std::array<int, batch_size>{};
+    auto sum = 0L;
+    while (popped.load(std::memory_order_relaxed) < total) {
+        auto count = std::size_t{0};
+        if (batch) {
+            count = queue.try_pop_batch(values);
+        }
+        else if (auto const x = queue.try_pop()) {
+            values[0] = *x;
+            count = 1;
+        }
+        if (count == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            sum += values[i];
+        }
+        popped.fetch_add(static_cast<int>(count), std::memory_order_relaxed);
+    }
+    zzz::bench::do_not_optimize(sum);
+}
+
+/// Move item_count values through \p Queue from \p producers to \p consumers threads.
+template <typename Queue>
+void transfer(std::string const& name, int producers, int consumers, bool batch)
+{
+    auto queue = Queue{1024};
+    zzz::bench::measure(
+        name + (batch ? ", batches" : "") + ", " + std::to_string(producers) + "P" +
+            std::to_string(consumers) + "C",
+        [&] {
+            auto popped = std::atomic<int>{0};
+            auto threads = std::vector<std::jthread>{};
+            for (auto i = 0; i < producers; ++i) {
+                threads.emplace_back(
+                    [&] { produce(queue, item_count / producers, batch); });
+            }
+            for (auto i = 0; i < consumers; ++i) {
+                threads.emplace_back([&] {
+                    consume(queue, popped, item_count / producers * producers, batch);
+                });
+            }
+        },
+        item_count);
+}
+
+/// Bounce a value between two threads through a pair of \p Queue, one way each.
+template <typename Queue>
+void ping_pong(std::string const& name)
+{
+    auto ping = Queue{16};
+    auto pong = Queue{16};
+    zzz::bench::measure(
+        name + ", round trips",
+        [&] {
+            auto echo = std::jthread{[&] {
+                for (auto i = 0; i < round_trips; ++i) {
+                    auto x = ping.try_pop();
+                    for (; !x; x = ping.try_pop()) {
+                        std::this_thread::yield();
+                    }
+                    while (!pong.try_push(*x)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }};
+            for (auto i = 0; i < round_trips; ++i) {
+                while (!ping.try_push(i)) {
+                    std::this_thread::yield();
+                }
+                auto x = pong.try_pop();
+                for (; !x; x = pong.try_pop()) {
+                    std::this_thread::yield();
+                }
+                zzz::bench::do_not_optimize(*x);
+            }
+        },
+        round_trips);
+}
+
+}  // namespace
+
+BENCH(bounded_queue_1p1c)
+{
+    for (auto batch : {false, true}) {
+        transfer<zzz::SpscQueue<int>>("SpscQueue", 1, 1, batch);
+        transfer<zzz::MpmcQueue<int>>("MpmcQueue", 1, 1, batch);
+        transfer<MutexQueue<int>>("mutex deque", 1, 1, batch);
+    }
+}
+
+BENCH(bounded_queue_npnc)
+{
+    for (auto threads : {2, 4}) {
+        for (auto batch : {false, true}) {
+            transfer<zzz::MpmcQueue<int>>("MpmcQueue", threads, threads, batch);
+            transfer<MutexQueue<int>>("mutex deque", threads, threads, batch);
+        }
+    }
+}
+
+BENCH(bounded_queue_latency)
+{
+    ping_pong<zzz::SpscQueue<int>>("SpscQueue");
+    ping_pong<zzz::MpmcQueue<int>>("MpmcQueue");
+    ping_pong<MutexQueue<int>>("mutex deque");
+}
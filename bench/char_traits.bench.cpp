@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <zzz/char_traits.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+/// About 8MB of indented lines mixing words and numbers.
+[[nodiscard]] auto make_text() -> std::string const&
+{
+    static auto const text = [] {
+        auto result = std::string{};
+        for (auto i = 0; result.size() < 8'000'000; ++i) {
+            result += std::string(static_cast<std::size_t>(i % 40), ' ') + "key_" +
+                      std::to_string(i) + " = value " + std::to_string(i * 7) + ";\n";
+        }
+        return result;
+    }();
+    return text;
+}
+
+}  // namespace
+
+BENCH(char_class_predicates)
+{
+    auto const& x = make_text();
+
+    zzz::bench::measure(
+        "std::isalnum count",
+        [&] {
+            auto const n = std::count_if(x.begin(), x.end(), [](char c) {
+                return std::isalnum(static_cast<unsigned char>(c)) != 0;
+            });
+            zzz::bench::do_not_optimize(n);
+        },
+        x.size());
+
+    zzz::bench::measure(
+        "zzz::is_alphanumeric count",
+        [&] {
+            auto const n = std::count_if(x.begin(), x.end(), zzz::is_alphanumeric);
+            zzz::bench::do_not_optimize(n);
+        },
+        x.size());
+}
+
+BENCH(char_class_bulk)
+{
+    auto const& x = make_text();
+
+    zzz::bench::measure(
+        "std::isdigit count",
+        [&] {
+            auto const n = std::count_if(x.begin(), x.end(), [](char c) {
+                return std::isdigit(static_cast<unsigned char>(c)) != 0;
+            });
+            zzz::bench::do_not_optimize(n);
+        },
+        x.size());
+
+    zzz::bench::measure(
+        "zzz::count_digits",
+        [&] { zzz::bench::do_not_optimize(zzz::count_digits(x)); }, x.size());
+
+    // Skip the indentation of every line.
+    auto const lines = [&] {
+        auto result = std::vector<std::string_view>{};
+        auto rest = std::string_view{x};
+        while (!rest.empty()) {
+            auto const end = rest.find('\n');
+            result.push_back(rest.substr(0, end));
+            rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+        }
+        return result;
+    }();
+
+    zzz::bench::measure(
+        "std::isspace skip indentation",
+        [&] {
+            auto total = std::size_t{0};
+            for (auto line : lines) {
+                auto const at = std::find_if(line.begin(), line.end(), [](char c) {
+                    return std::isspace(static_cast<unsigned char>(c)) == 0;
+                });
+                total += static_cast<std::size_t>(at - line.begin());
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        x.size());
+
+    zzz::bench::measure(
+        "zzz::find_first_not_whitespace skip indentation",
+        [&] {
+            auto total = std::size_t{0};
+            for (auto line : lines) {
+                total += static_cast<std::size_t>(
+                    zzz::find_first_not_whitespace(line) - line.begin());
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        x.size());
+}
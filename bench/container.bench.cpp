@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <zzz/container.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+/// A mapped value that is expensive to copy.
+struct BigStruct {
+    std::array<double, 32> values;
+    std::string name;
+};
+
+/// Hash for heterogeneous lookup of std::string keys.
+struct StringHash {
+    using is_transparent = void;
+    auto operator()(std::string_view x) const -> std::size_t
+    {
+        return std::hash<std::string_view>{}(x);
+    }
+};
+
+using BigMap = std::unordered_map<std::string, BigStruct, StringHash, std::equal_to<>>;
+
+/// One million entries, larger than the caches.
+[[nodiscard]] auto make_big_map() -> BigMap const&
+{
+    static auto const map = [] {
+        auto result = BigMap{};
+        result.reserve(1'000'000);
+        for (auto i = 0; i < 1'000'000; ++i) {
+            auto key = "user:" + std::to_string(i * 2'654'435'761u);
+            result.emplace(key, BigStruct{{}, key});
+        }
+        return result;
+    }();
+    return map;
+}
+
+/// Keys in random order, half of them present in the map.
+[[nodiscard]] auto make_keys(std::size_t count) -> std::vector<std::string>
+{
+    auto gen = std::mt19937{42};
+    auto result = std::vector<std::string>{};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        auto const n = gen() % 2'000'000;
+        result.push_back("user:" + std::to_string(
+                                       (n % 2 == 0 ? n / 2 : n) * 2'654'435'761u));
+    }
+    return result;
+}
+
+}  // namespace
+
+BENCH(lookup_big_values)
+{
+    auto const& map = make_big_map();
+    auto const keys = make_keys(100'000);
+    auto views = std::vector<std::string_view>(keys.begin(), keys.end());
+
+    zzz::bench::measure(
+        "lookup, copies value",
+        [&] {
+            auto hits = std::size_t{0};
+            for (auto const& key : keys) {
+                hits += zzz::lookup(map, key).has_value();
+            }
+            zzz::bench::do_not_optimize(hits);
+        },
+        keys.size());
+
+    zzz::bench::measure(
+        "lookup_ptr, std::string key",
+        [&] {
+            auto hits = std::size_t{0};
+            for (auto const& key : keys) {
+                hits += zzz::lookup_ptr(map, key) != nullptr;
+            }
+            zzz::bench::do_not_optimize(hits);
+        },
+        keys.size());
+
+    zzz::bench::measure(
+        "lookup_ptr, std::string_view key",
+        [&] {
+            auto hits = std::size_t{0};
+            for (auto key : views) {
+                hits += zzz::lookup_ptr(map, key) != nullptr;
+            }
+            zzz::bench::do_not_optimize(hits);
+        },
+        keys.size());
+
+    auto out = std::vector<BigStruct const*>(views.size());
+    zzz::bench::measure(
+        "lookup_batch, std::string_view keys",
+        [&] {
+            zzz::lookup_batch(map, views, out);
+            zzz::bench::do_not_optimize(out.data());
+        },
+        keys.size());
+}
+
+namespace {
+
+/// Scan \p size elements of \p T for a value that is not there, a full pass.
+template <typename T>
+void measure_find_values(std::string const& type, std::size_t size)
+{
+    auto const x = std::vector<T>(size, T{1});
+    auto const label = type + ", " + std::to_string(size);
+
+    zzz::bench::measure(
+        "std::find " + label,
+        [&] {
+            auto const at = std::find(x.begin(), x.end(), T{2});
+            zzz::bench::do_not_optimize(at);
+        },
+        size);
+
+    zzz::bench::measure(
+        "zzz::find " + label,
+        [&] {
+            auto const at = zzz::find(x, T{2});
+            zzz::bench::do_not_optimize(at);
+        },
+        size);
+
+    zzz::bench::measure(
+        "zzz::find_all " + label,
+        [&] {
+            auto const bits = zzz::find_all(x, T{2});
+            zzz::bench::do_not_optimize(bits.data());
+        },
+        size);
+}
+
+}  // namespace
+
+BENCH(find_values)
+{
+    for (auto size : {std::size_t{1'000}, std::size_t{1'000'000}}) {
+        measure_find_values<std::uint16_t>("uint16_t", size);
+        measure_find_values<int>("int", size);
+        measure_find_values<std::int64_t>("int64_t", size);
+        measure_find_values<float>("float", size);
+        measure_find_values<double>("double", size);
+    }
+}
@@ -0,0 +1,134 @@
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <zzz/coro.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+constexpr auto generator_count = 100'000;
+
+auto pooled(int end) -> zzz::Generator<int>
+{
+    for (auto i = 0; i < end; ++i) {
+        co_yield i;
+    }
+}
+
+/// Same as pooled, with the frame from std::allocator, i.e. global operator new.
+auto unpooled(std::allocator_arg_t, std::allocator<std::byte>, int end)
+    -> zzz::Generator<int>
+{
+    for (auto i = 0; i < end; ++i) {
+        co_yield i;
+    }
+}
+
+/// Binary tree stored in an array, children of i are 2i + 1 and 2i + 2.
+struct Tree {
+    std::vector<int> values;
+
+    [[nodiscard]] auto has(std::size_t i) const -> bool { return i < values.size(); }
+};
+
+/// Pre-order walk, re-yielding each value of the subtrees at every level.
+auto walk_reyield(Tree const& tree, std::size_t i) -> zzz::Generator<int>
+{
+    if (!tree.has(i)) co_return;
+    co_yield int{tree.values[i]};
+    for (auto x : walk_reyield(tree, 2 * i + 1)) {
+        co_yield x;
+    }
+    for (auto x : walk_reyield(tree, 2 * i + 2)) {
+        co_yield x;
+    }
+}
+
+/// Pre-order walk, yielding the subtrees with elements_of.
+auto walk_nested(Tree const& tree, std::size_t i) -> zzz::Generator<int>
+{
+    if (!tree.has(i)) co_return;
+    co_yield int{tree.values[i]};
+    co_yield zzz::elements_of(walk_nested(tree, 2 * i + 1));
+    co_yield zzz::elements_of(walk_nested(tree, 2 * i + 2));
+}
+
+/// Degenerate tree, a path of \p depth nodes.
+auto path_reyield(int depth) -> zzz::Generator<int>
+{
+    if (depth == 0) co_return;
+    co_yield depth;
+    for (auto x : path_reyield(depth - 1)) {
+        co_yield x;
+    }
+}
+
+auto path_nested(int depth) -> zzz::Generator<int>
+{
+    if (depth == 0) co_return;
+    co_yield depth;
+    co_yield zzz::elements_of(path_nested(depth - 1));
+}
+
+template <typename F>
+void measure_walk(char const* label, std::size_t items, F const& walk)
+{
+    zzz::bench::measure(
+        label,
+        [&] {
+            auto sum = 0;
+            for (auto x : walk()) {
+                sum += x;
+            }
+            zzz::bench::do_not_optimize(sum);
+        },
+        items);
+}
+
+}  // namespace
+
+BENCH(generator_frames)
+{
+    zzz::bench::measure(
+        "create and drain, frame pool",
+        [] {
+            auto sum = 0;
+            for (auto i = 0; i < generator_count; ++i) {
+                for (auto x : pooled(4)) {
+                    sum += x;
+                }
+            }
+            zzz::bench::do_not_optimize(sum);
+        },
+        generator_count);
+
+    zzz::bench::measure(
+        "create and drain, operator new",
+        [] {
+            auto sum = 0;
+            for (auto i = 0; i < generator_count; ++i) {
+                for (auto x : unpooled(std::allocator_arg, {}, 4)) {
+                    sum += x;
+                }
+            }
+            zzz::bench::do_not_optimize(sum);
+        },
+        generator_count);
+}
+
+BENCH(generator_nested)
+{
+    // Depth 16.
+    auto const tree = Tree{std::vector<int>((1 << 16) - 1, 1)};
+    auto const size = tree.values.size();
+    measure_walk("binary tree, re-yield", size,
+                 [&] { return walk_reyield(tree, 0); });
+    measure_walk("binary tree, elements_of", size,
+                 [&] { return walk_nested(tree, 0); });
+
+    constexpr auto depth = 1'000;
+    measure_walk("path, re-yield", depth, [] { return path_reyield(depth); });
+    measure_walk("path, elements_of", depth, [] { return path_nested(depth); });
+}
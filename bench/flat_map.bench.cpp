@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <zzz/container.hpp>
+#include <zzz/flat_map.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+/// Table sizes from cache resident to far beyond the caches. 10^8 entries would
+/// need several GB per table, more than the benchmark machines have.
+constexpr std::size_t sizes[] = {1'000, 10'000, 100'000, 1'000'000, 10'000'000};
+
+/// Lookups per measured call, so the call time doesn't scale with the table size.
+constexpr std::size_t lookup_count = 100'000;
+
+/// Distinct random keys, the first \p count are inserted.
+[[nodiscard]] auto make_keys(std::size_t count) -> std::vector<std::uint64_t>
+{
+    auto gen = std::mt19937_64{42};
+    auto result = std::vector<std::uint64_t>(count);
+    std::generate(result.begin(), result.end(), gen);
+    return result;
+}
+
+/// Random keys, one in two of them from \p keys.
+[[nodiscard]] auto make_queries(std::vector<std::uint64_t> const& keys)
+    -> std::vector<std::uint64_t>
+{
+    auto gen = std::mt19937_64{7};
+    auto result = std::vector<std::uint64_t>(lookup_count);
+    for (auto& x : result) {
+        x = gen() % 2 == 0 ? keys[gen() % keys.size()] : gen();
+    }
+    return result;
+}
+
+template <typename Map>
+void bench_map(std::string const& name, std::vector<std::uint64_t> const& keys)
+{
+    auto const label = name + ", " + std::to_string(keys.size());
+
+    zzz::bench::measure(
+        label + " insert",
+        [&] {
+            auto map = Map{};
+            for (auto key : keys) {
+                map.try_emplace(key, key);
+            }
+            zzz::bench::do_not_optimize(map.size());
+        },
+        keys.size());
+
+    auto map = Map{};
+    for (auto key : keys) {
+        map.try_emplace(key, key);
+    }
+    auto const queries = make_queries(keys);
+    zzz::bench::measure(
+        label + " find, half hits",
+        [&] {
+            auto sum = std::uint64_t{0};
+            for (auto key : queries) {
+                if (auto const at = map.find(key); at != map.end()) sum += at->second;
+            }
+            zzz::bench::do_not_optimize(sum);
+        },
+        queries.size());
+
+    auto out = std::vector<std::uint64_t const*>(queries.size());
+    zzz::bench::measure(
+        label + " lookup_batch, half hits",
+        [&] {
+            zzz::lookup_batch(map, queries, out);
+            zzz::bench::do_not_optimize(out.data());
+        },
+        queries.size());
+}
+
+}  // namespace
+
+BENCH(flat_map)
+{
+    for (auto size : sizes) {
+        auto const keys = make_keys(size);
+        bench_map<zzz::FlatMap<std::uint64_t, std::uint64_t>>("FlatMap", keys);
+        bench_map<std::unordered_map<std::uint64_t, std::uint64_t>>("unordered_map",
+                                                                     keys);
+    }
+}
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <zzz/container.hpp>
+#include <zzz/flat_ordered.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+/// From cache resident to cache cold tables.
+constexpr std::size_t sizes[] = {1'000, 100'000, 10'000'000};
+
+/// Lookups per measured call, so the call time doesn't scale with the table size.
+constexpr std::size_t lookup_count = 100'000;
+
+[[nodiscard]] auto make_values(std::size_t count)
+    -> std::vector<std::pair<std::uint64_t, std::uint64_t>>
+{
+    auto gen = std::mt19937_64{42};
+    auto result = std::vector<std::pair<std::uint64_t, std::uint64_t>>(count);
+    for (auto& [key, value] : result) {
+        key = gen();
+        value = key / 2;
+    }
+    return result;
+}
+
+/// Random keys, one in two of them present; random order defeats the caches.
+[[nodiscard]] auto make_queries(
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> const& values)
+    -> std::vector<std::uint64_t>
+{
+    auto gen = std::mt19937_64{7};
+    auto result = std::vector<std::uint64_t>(lookup_count);
+    for (auto& x : result) {
+        x = gen() % 2 == 0 ? values[gen() % values.size()].first : gen();
+    }
+    return result;
+}
+
+template <typename Map>
+void bench_lookup(std::string const& label,
+                  Map const& map,
+                  std::vector<std::uint64_t> const& queries)
+{
+    zzz::bench::measure(
+        label,
+        [&] {
+            auto sum = std::uint64_t{0};
+            for (auto key : queries) {
+                if (auto const value = zzz::lookup_ptr(map, key)) sum += *value;
+            }
+            zzz::bench::do_not_optimize(sum);
+        },
+        queries.size());
+}
+
+}  // namespace
+
+BENCH(flat_ordered_map)
+{
+    for (auto size : sizes) {
+        auto const values = make_values(size);
+        auto const queries = make_queries(values);
+        auto const suffix = ", " + std::to_string(size);
+
+        zzz::bench::measure(
+            "FlatOrderedMap build" + suffix,
+            [&] {
+                auto map = zzz::FlatOrderedMap<std::uint64_t, std::uint64_t>{values};
+                zzz::bench::do_not_optimize(map.size());
+            },
+            size, std::chrono::milliseconds{0});
+
+        auto const flat = zzz::FlatOrderedMap<std::uint64_t, std::uint64_t>{values};
+        bench_lookup("FlatOrderedMap lookup" + suffix, flat, queries);
+
+        auto const tree =
+            std::map<std::uint64_t, std::uint64_t>(values.begin(), values.end());
+        bench_lookup("std::map lookup" + suffix, tree, queries);
+    }
+}
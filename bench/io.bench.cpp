@@ -0,0 +1,159 @@
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <zzz/io.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+/// About 32MB of log lines.
+[[nodiscard]] auto make_log() -> std::string&
+{
+    static auto text = [] {
+        auto result = std::string{};
+        for (auto i = 0; result.size() < 32'000'000; ++i) {
+            result += "2024-01-01T00:00:00 INFO [worker-" + std::to_string(i % 16) +
+                      "] request " + std::to_string(i) + " completed\n";
+        }
+        return result;
+    }();
+    return text;
+}
+
+/// Stream over memory that is already in place, so no copy is timed.
+class MemoryBuffer : public std::streambuf {
+   public:
+    explicit MemoryBuffer(std::string& x)
+    {
+        this->setg(x.data(), x.data(), x.data() + x.size());
+    }
+};
+
+}  // namespace
+
+BENCH(read_lines)
+{
+    auto& x = make_log();
+
+    zzz::bench::measure(
+        "std::getline",
+        [&] {
+            auto buffer = MemoryBuffer{x};
+            auto is = std::istream{&buffer};
+            auto total = std::size_t{0};
+            auto line = std::string{};
+            while (std::getline(is, line)) {
+                total += line.size();
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        x.size());
+
+    zzz::bench::measure(
+        "zzz::getline",
+        [&] {
+            auto buffer = MemoryBuffer{x};
+            auto is = std::istream{&buffer};
+            auto total = std::size_t{0};
+            while (auto line = zzz::getline(is)) {
+                total += line->size();
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        x.size());
+
+    zzz::bench::measure(
+        "zzz::LineReader::next",
+        [&] {
+            auto buffer = MemoryBuffer{x};
+            auto is = std::istream{&buffer};
+            auto reader = zzz::LineReader{is};
+            auto total = std::size_t{0};
+            while (auto line = reader.next()) {
+                total += line->size();
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        x.size());
+
+    zzz::bench::measure(
+        "zzz::LineReader::lines",
+        [&] {
+            auto buffer = MemoryBuffer{x};
+            auto is = std::istream{&buffer};
+            auto reader = zzz::LineReader{is};
+            auto total = std::size_t{0};
+            for (auto line : reader.lines()) {
+                total += line.size();
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        x.size());
+}
+
+namespace {
+
+/// The element by element operator<< path print used to take.
+template <typename Iterable>
+void print_with_ostream(std::ostream& os, Iterable const& x)
+{
+    os << "{ ";
+    auto first = true;
+    for (auto const& element : x) {
+        if (!first) { os << ", "; }
+        first = false;
+        os << element;
+    }
+    os << " }";
+}
+
+}  // namespace
+
+BENCH(print)
+{
+    auto ints = std::vector<int>(1'000'000);
+    auto doubles = std::vector<double>(1'000'000);
+    for (auto i = std::size_t{0}; i < ints.size(); ++i) {
+        ints[i] = static_cast<int>(i * 7919 % 1'000'003);
+        doubles[i] = static_cast<double>(ints[i]) / 7.0;
+    }
+
+    auto ss = std::ostringstream{};
+    auto const run = [&](std::string const& label, auto const& x) {
+        zzz::bench::measure(
+            "operator<< per element, " + label,
+            [&] {
+                ss.str({});
+                print_with_ostream(ss, x);
+                zzz::bench::do_not_optimize(ss);
+            },
+            x.size());
+
+        zzz::bench::measure(
+            "zzz::print to ostream, " + label,
+            [&] {
+                ss.str({});
+                zzz::print(ss, x);
+                zzz::bench::do_not_optimize(ss);
+            },
+            x.size());
+
+        auto buffer = std::string{};
+        zzz::bench::measure(
+            "zzz::print to string, " + label,
+            [&] {
+                buffer.clear();
+                zzz::print(buffer, x);
+                zzz::bench::do_not_optimize(buffer.data());
+            },
+            x.size());
+    };
+    run("1M ints", ints);
+    run("1M doubles", doubles);
+}
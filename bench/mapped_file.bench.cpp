@@ -0,0 +1,78 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <zzz/io.hpp>
+#include <zzz/mapped_file.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+/// About 32MB of comma separated lines, written once to the temporary directory.
+[[nodiscard]] auto make_file() -> std::filesystem::path const&
+{
+    static auto const path = [] {
+        auto const result =
+            std::filesystem::temp_directory_path() / "zzz.mapped_file.bench.csv";
+        auto os = std::ofstream{result, std::ios::binary};
+        for (auto i = 0, size = 0; size < 32'000'000; ++i) {
+            auto const line = "2024-01-01T00:00:00,host" + std::to_string(i % 97) +
+                              ",INFO," + std::to_string(i) + ",message text\n";
+            os << line;
+            size += static_cast<int>(line.size());
+        }
+        return result;
+    }();
+    return path;
+}
+
+}  // namespace
+
+BENCH(parse_file)
+{
+    auto const& path = make_file();
+    auto const bytes = std::filesystem::file_size(path);
+
+    zzz::bench::measure(
+        "std::ifstream, zzz::getline, zzz::split",
+        [&] {
+            auto is = std::ifstream{path};
+            auto total = std::size_t{0};
+            while (auto line = zzz::getline(is)) {
+                total += zzz::split(*line, ",").size();
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        bytes);
+
+    zzz::bench::measure(
+        "std::ifstream, zzz::LineReader, zzz::split_view",
+        [&] {
+            auto is = std::ifstream{path};
+            auto reader = zzz::LineReader{is};
+            auto total = std::size_t{0};
+            while (auto line = reader.next()) {
+                for (auto field : zzz::split_view(*line, ",")) {
+                    total += field.size();
+                }
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        bytes);
+
+    zzz::bench::measure(
+        "zzz::MappedFile, zzz::split_view",
+        [&] {
+            auto const file = zzz::MappedFile{path};
+            auto total = std::size_t{0};
+            for (auto line : file.lines()) {
+                for (auto field : zzz::split_view(line, ",")) {
+                    total += field.size();
+                }
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        bytes);
+}
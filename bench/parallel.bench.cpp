@@ -0,0 +1,100 @@
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <zzz/parallel.hpp>
+#include <zzz/parallel_policy.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+/// About 64MB of comma separated lines.
+[[nodiscard]] auto make_csv() -> std::string const&
+{
+    static auto const text = [] {
+        auto result = std::string{};
+        for (auto i = 0; result.size() < 64'000'000; ++i) {
+            result += "2024-01-01T00:00:00,host" + std::to_string(i % 97) + ",INFO," +
+                      std::to_string(i) + ",message text\n";
+        }
+        return result;
+    }();
+    return text;
+}
+
+}  // namespace
+
+BENCH(reduce_lines_scaling)
+{
+    auto const& x = make_csv();
+
+    // Count the fields of every line.
+    auto const fields = [](std::size_t total, std::string_view line) {
+        for (auto field : zzz::split_view(line, ",")) {
+            total += field.empty() ? 0 : 1;
+        }
+        return total;
+    };
+
+    for (auto chunks = std::size_t{1}; chunks <= zzz::default_thread_count();
+         chunks *= 2) {
+        zzz::bench::measure(
+            "reduce_lines, " + std::to_string(chunks) + " chunks",
+            [&] {
+                zzz::bench::do_not_optimize(zzz::reduce_lines(
+                    fields, std::plus{}, std::size_t{0}, x, chunks));
+            },
+            x.size());
+    }
+}
+
+BENCH(reduce_serial_vs_parallel)
+{
+    static auto const x = [] {
+        auto result = std::vector<std::int32_t>(100'000'000);
+        for (auto i = std::size_t{0}; i < result.size(); ++i) {
+            result[i] = static_cast<std::int32_t>(i % 1'000);
+        }
+        return result;
+    }();
+    auto const sum = [](std::int64_t total, std::int64_t value) {
+        return total + value;
+    };
+
+    zzz::bench::measure(
+        "reduce, serial",
+        [&] { zzz::bench::do_not_optimize(zzz::reduce(sum, std::int64_t{0}, x)); },
+        x.size());
+
+    zzz::bench::measure(
+        "reduce, std::execution::seq",
+        [&] {
+            zzz::bench::do_not_optimize(
+                zzz::reduce(std::execution::seq, sum, std::int64_t{0}, x));
+        },
+        x.size());
+
+    for (auto chunks = std::size_t{1}; chunks <= zzz::default_thread_count();
+         chunks *= 2) {
+        zzz::bench::measure(
+            "reduce, " + std::to_string(chunks) + " chunks",
+            [&] {
+                zzz::bench::do_not_optimize(
+                    zzz::reduce(sum, std::int64_t{0}, x, chunks));
+            },
+            x.size());
+    }
+
+    zzz::bench::measure(
+        "reduce, std::execution::par",
+        [&] {
+            zzz::bench::do_not_optimize(
+                zzz::reduce(std::execution::par, sum, std::int64_t{0}, x));
+        },
+        x.size());
+}
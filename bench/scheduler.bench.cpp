@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zzz/scheduler.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+constexpr auto task_count = 100'000;
+
+auto noop(zzz::Scheduler& scheduler) -> zzz::Task<int>
+{
+    co_await scheduler.schedule();
+    co_return 1;
+}
+
+/// Schedule \p count tasks from a worker, so that they go to its deque and the other
+/// workers steal them.
+auto spawn(zzz::Scheduler& scheduler, int count) -> zzz::Task<int>
+{
+    co_await scheduler.schedule();
+    auto tasks = std::vector<zzz::Task<int>>{};
+    tasks.reserve(static_cast<std::size_t>(count));
+    for (auto i = 0; i < count; ++i) {
+        tasks.push_back(noop(scheduler));
+    }
+    auto sum = 0;
+    for (auto x : co_await zzz::when_all(std::move(tasks))) {
+        sum += x;
+    }
+    co_return sum;
+}
+
+/// Thread counts from one to twice the hardware threads, by powers of two.
+[[nodiscard]] auto thread_counts() -> std::vector<std::size_t>
+{
+    auto const hardware = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    auto result = std::vector<std::size_t>{};
+    for (auto count = std::size_t{1}; count <= 2 * hardware; count *= 2) {
+        result.push_back(count);
+    }
+    return result;
+}
+
+}  // namespace
+
+BENCH(scheduler_throughput)
+{
+    for (auto thread_count : thread_counts()) {
+        auto scheduler = zzz::Scheduler{thread_count};
+        zzz::bench::measure(
+            "tasks, " + std::to_string(thread_count) + " threads",
+            [&] {
+                auto const sum = zzz::sync_wait(spawn(scheduler, task_count));
+                zzz::bench::do_not_optimize(sum);
+            },
+            task_count);
+    }
+}
+
+BENCH(scheduler_fan_out)
+{
+    // Time from scheduling a batch of tasks on a worker to resuming after the last.
+    for (auto thread_count : thread_counts()) {
+        auto scheduler = zzz::Scheduler{thread_count};
+        for (auto fan_out : {1, 16, 256}) {
+            zzz::bench::measure(
+                "fan out " + std::to_string(fan_out) + ", " +
+                    std::to_string(thread_count) + " threads",
+                [&] {
+                    auto const sum = zzz::sync_wait(spawn(scheduler, fan_out));
+                    zzz::bench::do_not_optimize(sum);
+                });
+        }
+    }
+}
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <zzz/string.hpp>
+
+#define BENCH_MAIN
+#include "./bench.hpp"
+
+namespace {
+
+/// About 8MB of comma separated lines with eight fields each.
+[[nodiscard]] auto make_csv() -> std::string const&
+{
+    static auto const text = [] {
+        auto result = std::string{};
+        for (auto i = 0; result.size() < 8'000'000; ++i) {
+            result += "2024-01-01T00:00:00,host" + std::to_string(i % 97) +
+                      ",INFO,service,42," + std::to_string(i) + ",,message text\n";
+        }
+        return result;
+    }();
+    return text;
+}
+
+}  // namespace
+
+BENCH(split_vs_split_view)
+{
+    auto const& x = make_csv();
+
+    zzz::bench::measure(
+        "split, all fields",
+        [&] {
+            auto total = std::size_t{0};
+            for (auto segment : zzz::split(x, ",")) {
+                total += segment.size();
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        x.size());
+
+    zzz::bench::measure(
+        "split_view, all fields",
+        [&] {
+            auto total = std::size_t{0};
+            for (auto segment : zzz::split_view(x, ",")) {
+                total += segment.size();
+            }
+            zzz::bench::do_not_optimize(total);
+        },
+        x.size());
+
+    zzz::bench::measure("split, first 3 fields", [&] {
+        auto const fields = zzz::split(x, ",");
+        zzz::bench::do_not_optimize(fields[2]);
+    });
+
+    zzz::bench::measure("split_view, first 3 fields", [&] {
+        for (auto segment : zzz::split_view(x, ",") | std::views::take(3)) {
+            zzz::bench::do_not_optimize(segment);
+        }
+    });
+}
+
+BENCH(find_char)
+{
+    auto const& x = make_csv();
+    auto const view = std::string_view{x};
+
+    zzz::bench::measure(
+        "std::find, absent char",
+        [&] {
+            zzz::bench::do_not_optimize(std::find(view.begin(), view.end(), '|'));
+        },
+        view.size());
+
+    zzz::bench::measure(
+        "zzz::find, absent char",
+        [&] { zzz::bench::do_not_optimize(zzz::find(view, '|')); }, view.size());
+
+    zzz::bench::measure(
+        "zzz::split, single char delimiter",
+        [&] { zzz::bench::do_not_optimize(zzz::split(view, ",").size()); },
+        view.size());
+}
+
+BENCH(find_segment)
+{
+    auto const& x = make_csv();
+    auto const view = std::string_view{x};
+
+    auto const search = [&](std::string_view needle) {
+        return std::search(view.begin(), view.end(), needle.begin(), needle.end());
+    };
+
+    for (auto const needle : {std::string_view{"message text?"},
+                              std::string_view{"2024-01-01T00:00:00,host42,INFO,"
+                                               "service,42,not-there"}}) {
+        auto const label = std::to_string(needle.size()) + " byte needle";
+        zzz::bench::measure(
+            "std::search, " + label,
+            [&] { zzz::bench::do_not_optimize(search(needle)); },
+            view.size());
+
+        auto const searcher = zzz::Searcher{needle};
+        zzz::bench::measure(
+            "zzz::Searcher, " + label,
+            [&] { zzz::bench::do_not_optimize(searcher(view)); }, view.size());
+    }
+
+    {  // Quadratic case for std::search.
+        auto const haystack = std::string(1'000'000, 'a');
+        auto const needle = std::string(1'000, 'a') + "b";
+        zzz::bench::measure(
+            "std::search, periodic needle",
+            [&] {
+                zzz::bench::do_not_optimize(std::search(
+                    haystack.begin(), haystack.end(), needle.begin(), needle.end()));
+            },
+            haystack.size());
+
+        auto const searcher = zzz::Searcher{needle};
+        zzz::bench::measure(
+            "zzz::Searcher, periodic needle",
+            [&] { zzz::bench::do_not_optimize(searcher(haystack)); }, haystack.size());
+    }
+}
+
+BENCH(uppercase)
+{
+    auto const& x = make_csv();
+
+    zzz::bench::measure(
+        "std::toupper per character",
+        [&] {
+            auto result = std::string{};
+            result.reserve(x.size());
+            for (auto c : x) {
+                result.push_back(static_cast<char>(std::toupper(c)));
+            }
+            zzz::bench::do_not_optimize(result.data());
+        },
+        x.size());
+
+    zzz::bench::measure(
+        "zzz::uppercase",
+        [&] { zzz::bench::do_not_optimize(zzz::uppercase(x).data()); }, x.size());
+
+    auto buffer = std::string(x.size(), '\0');
+    zzz::bench::measure(
+        "zzz::uppercase, caller buffer",
+        [&] { zzz::bench::do_not_optimize(zzz::uppercase(x, buffer).data()); },
+        x.size());
+
+    zzz::bench::measure(
+        "zzz::uppercase_in_place",
+        [&] {
+            zzz::uppercase_in_place(buffer);
+            zzz::bench::do_not_optimize(buffer.data());
+        },
+        x.size());
+}
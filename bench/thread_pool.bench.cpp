@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zzz/thread_pool.hpp>
+
+#include "./bench.hpp"
+
+namespace {
+
+constexpr auto job_count = 100'000;
+
+/// The usual thread pool, for comparison: one queue of std::function behind a mutex.
+class MutexQueuePool {
+   public:
+    explicit MutexQueuePool(std::size_t thread_count)
+    {
+        for (auto i = std::size_t{0}; i < thread_count; ++i) {
+            threads_.emplace_back([this] { run(); });
+        }
+    }
+
+    ~MutexQueuePool()
+    {
+        {
+            auto const lock = std::lock_guard{mutex_};
+            stop_ = true;
+        }
+        ready_.notify_all();
+        threads_.clear();
+    }
+
+    void post(std::function<void()> fn)
+    {
+        {
+            auto const lock = std::lock_guard{mutex_};
+            jobs_.push_back(std::move(fn));
+        }
+        ready_.notify_one();
+    }
+
+   private:
+    void run()
+    {
+        while (true) {
+            auto lock = std::unique_lock{mutex_};
+            ready_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (jobs_.empty()) { return; }
+            auto fn = std::move(jobs_.front());
+            jobs_.pop_front();
+            lock.unlock();
+            fn();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> jobs_;
+    bool stop_{false};
+    std::vector<std::jthread> threads_;
+};
+
+/// Post \p count jobs that do next to nothing from a job, and wait for them.
+template <typename Pool>
+void fan_out(Pool& pool, int count)
+{
+    auto done = std::latch{count};
+    pool.post([&] {
+        for (auto i = 0; i < count; ++i) {
+            pool.post([&done] { done.count_down(); });
+        }
+    });
+    done.wait();
+}
+
+/// Thread counts from one to twice the hardware threads, by powers of two.
+[[nodiscard]] auto thread_counts() -> std::vector<std::size_t>
+{
+    auto const hardware = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    auto result = std::vector<std::size_t>{};
+    for (auto count = std::size_t{1}; count <= 2 * hardware; count *= 2) {
+        result.push_back(count);
+    }
+    return result;
+}
+
+}  // namespace
+
+BENCH(thread_pool_fine_grained)
+{
+    for (auto thread_count : thread_counts()) {
+        for (auto count : {64, job_count}) {
+            auto const label = std::to_string(count) + " jobs, " +
+                               std::to_string(thread_count) + " threads";
+            {
+                auto pool = zzz::ThreadPool{thread_count};
+                zzz::bench::measure(
+                    "work stealing, " + label, [&] { fan_out(pool, count); }, count);
+            }
+            {
+                auto pool = MutexQueuePool{thread_count};
+                zzz::bench::measure(
+                    "mutex queue, " + label, [&] { fan_out(pool, count); }, count);
+            }
+        }
+    }
+}
+
+BENCH(thread_pool_submit)
+{
+    for (auto thread_count : thread_counts()) {
+        auto pool = zzz::ThreadPool{thread_count};
+        zzz::bench::measure(
+            "submit and get, " + std::to_string(thread_count) + " threads",
+            [&] {
+                auto future = pool.submit([] { return 1; });
+                zzz::bench::do_not_optimize(future.get());
+            });
+    }
+}
+
+BENCH(thread_pool_parallel_for)
+{
+    constexpr auto size = std::size_t{1'000'000};
+    auto values = std::vector<float>(size, 1.0f);
+    for (auto thread_count : thread_counts()) {
+        auto const threads = ", " + std::to_string(thread_count) + " threads";
+        {
+            auto pool = zzz::ThreadPool{thread_count};
+            zzz::bench::measure(
+                "parallel_for" + threads,
+                [&] {
+                    pool.parallel_for(
+                        0, size, [&](std::size_t i) { values[i] += 1.0f; });
+                    zzz::bench::do_not_optimize(values.data());
+                },
+                size);
+        }
+        {
+            // One job per chunk of the same size as parallel_for's.
+            auto pool = MutexQueuePool{thread_count};
+            auto const chunk = std::max<std::size_t>(size / (8 * thread_count), 1);
+            auto const chunks = static_cast<std::ptrdiff_t>((size + chunk - 1) / chunk);
+            zzz::bench::measure(
+                "mutex queue chunks" + threads,
+                [&] {
+                    auto done = std::latch{chunks};
+                    for (auto begin = std::size_t{0}; begin < size; begin += chunk) {
+                        pool.post([&, begin] {
+                            auto const end = std::min(begin + chunk, size);
+                            for (auto i = begin; i < end; ++i) {
+                                values[i] += 1.0f;
+                            }
+                            done.count_down();
+                        });
+                    }
+                    done.wait();
+                    zzz::bench::do_not_optimize(values.data());
+                },
+                size);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <zzz/timer_service.hpp>
+
+#include "./bench.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr auto timer_count = std::size_t{100'000};
+
+/// Random delays between one second and a minute, spread over the upper levels.
+[[nodiscard]] auto make_delays(std::size_t count)
+    -> std::vector<std::chrono::milliseconds>
+{
+    auto gen = std::mt19937{42};
+    auto result = std::vector<std::chrono::milliseconds>(count);
+    for (auto& delay : result) {
+        delay = std::chrono::milliseconds{1'000 + gen() % 59'000};
+    }
+    return result;
+}
+
+}  // namespace
+
+BENCH(timer_service_schedule)
+{
+    auto service = zzz::TimerService{};
+    auto const delays = make_delays(timer_count);
+    auto handles = std::vector<zzz::TimerService::Handle>{};
+    handles.reserve(timer_count);
+
+    zzz::bench::measure(
+        "schedule and cancel",
+        [&] {
+            for (auto delay : delays) {
+                handles.push_back(service.schedule_after(delay, [] {}));
+            }
+            handles.clear();
+        },
+        timer_count);
+
+    // The same, with another 100k timers pending.
+    auto live = std::vector<zzz::TimerService::Handle>{};
+    for (auto delay : delays) {
+        live.push_back(service.schedule_every(delay, [] {}));
+    }
+    zzz::bench::measure(
+        "schedule and cancel, 100k live timers",
+        [&] {
+            for (auto delay : delays) {
+                handles.push_back(service.schedule_after(delay, [] {}));
+            }
+            handles.clear();
+        },
+        timer_count);
+}
+
+BENCH(timer_service_jitter)
+{
+    // 100k periodic timers firing between every 10ms and every second, while probe
+    // timers measure how late they fire.
+    auto service = zzz::TimerService{};
+    auto gen = std::mt19937{7};
+    auto fired = std::atomic<std::size_t>{0};
+    auto live = std::vector<zzz::TimerService::Handle>{};
+    for (auto i = std::size_t{0}; i < timer_count; ++i) {
+        auto const period = std::chrono::milliseconds{10 + gen() % 990};
+        live.push_back(service.schedule_every(period, [&] { ++fired; }));
+    }
+
+    constexpr auto probe_count = 2'000;
+    auto mutex = std::mutex{};
+    auto lateness = std::vector<std::chrono::microseconds>{};
+    auto probes = std::vector<zzz::TimerService::Handle>{};
+    for (auto i = 0; i < probe_count; ++i) {
+        auto const delay = std::chrono::microseconds{gen() % 2'000'000};
+        auto const deadline = std::chrono::steady_clock::now() + delay;
+        probes.push_back(service.schedule_after(delay, [&, deadline] {
+            auto const late = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - deadline);
+            auto const lock = std::lock_guard{mutex};
+            lateness.push_back(late);
+        }));
+    }
+    while (service.size() > timer_count) {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    auto const lock = std::lock_guard{mutex};
+    std::ranges::sort(lateness);
+    auto const at = [&](double q) {
+        return lateness[static_cast<std::size_t>(q * (lateness.size() - 1))].count();
+    };
+    std::cout << "  lateness, 1ms tick, " << fired.load() << " periodic firings\n"
+              << "    p50 " << at(0.5) << "us, p99 " << at(0.99) << "us, max "
+              << lateness.back().count() << "us\n";
+}
@@ -0,0 +1,554 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zzz {
+namespace detail {
+
+/// Base of every adaptor, lets `adaptor | fn` call fn(adaptor), e.g. zzz::reduce.
+struct AdaptorBase {
+    template <typename A, typename F>
+        requires std::derived_from<std::remove_cvref_t<A>, AdaptorBase> &&
+                 std::invocable<F, A&&>
+    friend auto operator|(A&& adaptor, F&& fn) -> decltype(auto)
+    {
+        return std::invoke(std::forward<F>(fn), std::forward<A>(adaptor));
+    }
+};
+
+/// Result of map(fn) and the like, `range | closure` adapts the range.
+template <typename F>
+struct AdaptorClosure {
+    template <std::ranges::input_range R>
+    friend auto operator|(R&& range, AdaptorClosure closure)
+    {
+        return std::move(closure.fn)(std::forward<R>(range));
+    }
+
+    F fn;
+};
+
+template <typename F>
+[[nodiscard]] auto make_closure(F fn) -> AdaptorClosure<F>
+{
+    return {std::move(fn)};
+}
+
+/// The range an adaptor reads, referenced if it's an lvalue, owned otherwise, e.g. a
+/// temporary Generator.
+/** Adaptors are single pass like Generator, so they read their range even when they
+ *  are const, as Generator does. */
+template <typename R>
+class AdaptorSource {
+   public:
+    using range_type = std::remove_cvref_t<R>;
+    using iterator = std::ranges::iterator_t<std::remove_reference_t<R>&>;
+    using sentinel = std::ranges::sentinel_t<std::remove_reference_t<R>&>;
+
+   public:
+    explicit AdaptorSource(R&& range) : range_{std::forward<R>(range)} {}
+
+    [[nodiscard]] auto begin() const -> iterator { return std::ranges::begin(get()); }
+    [[nodiscard]] auto end() const -> sentinel { return std::ranges::end(get()); }
+
+   private:
+    [[nodiscard]] auto get() const noexcept -> std::remove_reference_t<R>&
+    {
+        if constexpr (std::is_lvalue_reference_v<R>)
+            return range_.get();
+        else
+            return range_;
+    }
+
+    using Stored =
+        std::conditional_t<std::is_lvalue_reference_v<R>,
+                           std::reference_wrapper<std::remove_reference_t<R>>,
+                           range_type>;
+
+    mutable Stored range_;
+};
+
+template <typename R>
+using SourceReference = std::iter_reference_t<typename AdaptorSource<R>::iterator>;
+
+/// Iterator parts every adaptor shares, the position in the source and its end.
+template <typename R>
+struct SourcePosition {
+    auto done() const -> bool { return it == last; }
+
+    typename AdaptorSource<R>::iterator it;
+    typename AdaptorSource<R>::sentinel last;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Range of fn(x) for each x of a range, see zzz::map.
+ * @details Like the other adaptors here, Map is a plain object over the iterators of
+ * the range it adapts, a chain of adaptors over a Generator inlines into a single
+ * loop, without a coroutine frame or a resume per element and stage. Adaptors are
+ * single pass, iterate them once.
+ */
+template <typename R, typename F>
+class Map : public detail::AdaptorBase {
+   public:
+    using reference = std::invoke_result_t<F const&, detail::SourceReference<R>>;
+
+    class Iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cvref_t<reference>;
+
+        auto operator*() const -> reference { return std::invoke(*fn_, *pos_.it); }
+
+        auto operator++() -> Iterator&
+        {
+            ++pos_.it;
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        auto operator==(std::default_sentinel_t) const -> bool { return pos_.done(); }
+
+       private:
+        friend Map;
+
+        Iterator(detail::SourcePosition<R> pos, F const* fn)
+            : pos_{std::move(pos)}, fn_{fn}
+        {}
+
+        detail::SourcePosition<R> pos_;
+        F const* fn_;
+    };
+
+   public:
+    Map(R&& range, F fn) : source_{std::forward<R>(range)}, fn_{std::move(fn)} {}
+
+    [[nodiscard]] auto begin() const -> Iterator
+    {
+        return {{source_.begin(), source_.end()}, std::addressof(fn_)};
+    }
+
+    [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+   private:
+    detail::AdaptorSource<R> source_;
+    F fn_;
+};
+
+/// Range of the elements x of a range for which pred(x) is true, see zzz::filter.
+template <typename R, typename P>
+class Filter : public detail::AdaptorBase {
+   public:
+    using reference = detail::SourceReference<R>;
+
+    class Iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cvref_t<reference>;
+
+        auto operator*() const -> reference { return *pos_.it; }
+
+        auto operator++() -> Iterator&
+        {
+            ++pos_.it;
+            skip();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        auto operator==(std::default_sentinel_t) const -> bool { return pos_.done(); }
+
+       private:
+        friend Filter;
+
+        Iterator(detail::SourcePosition<R> pos, P const* pred)
+            : pos_{std::move(pos)}, pred_{pred}
+        {
+            skip();
+        }
+
+        /// Move to the next element that satisfies the predicate, or to the end.
+        void skip()
+        {
+            while (!pos_.done() && !std::invoke(*pred_, *pos_.it)) {
+                ++pos_.it;
+            }
+        }
+
+        detail::SourcePosition<R> pos_;
+        P const* pred_;
+    };
+
+   public:
+    Filter(R&& range, P pred) : source_{std::forward<R>(range)}, pred_{std::move(pred)}
+    {}
+
+    [[nodiscard]] auto begin() const -> Iterator
+    {
+        return {{source_.begin(), source_.end()}, std::addressof(pred_)};
+    }
+
+    [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+   private:
+    detail::AdaptorSource<R> source_;
+    P pred_;
+};
+
+/// Range of the first count elements of a range, see zzz::take.
+/** The range isn't advanced past the last element taken, so taking from an endless
+ *  Generator doesn't compute one element too many. */
+template <typename R>
+class Take : public detail::AdaptorBase {
+   public:
+    using reference = detail::SourceReference<R>;
+
+    class Iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cvref_t<reference>;
+
+        auto operator*() const -> reference { return *pos_.it; }
+
+        auto operator++() -> Iterator&
+        {
+            if (--remaining_ != 0) { ++pos_.it; }
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        auto operator==(std::default_sentinel_t) const -> bool
+        {
+            return remaining_ == 0 || pos_.done();
+        }
+
+       private:
+        friend Take;
+
+        Iterator(detail::SourcePosition<R> pos, std::size_t count)
+            : pos_{std::move(pos)}, remaining_{count}
+        {}
+
+        detail::SourcePosition<R> pos_;
+        std::size_t remaining_;
+    };
+
+   public:
+    Take(R&& range, std::size_t count) : source_{std::forward<R>(range)}, count_{count}
+    {}
+
+    [[nodiscard]] auto begin() const -> Iterator
+    {
+        return {{source_.begin(), source_.end()}, count_};
+    }
+
+    [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+   private:
+    detail::AdaptorSource<R> source_;
+    std::size_t count_;
+};
+
+/// Range of spans over consecutive groups of size elements of a range, the last one
+/// may be shorter, see zzz::chunk.
+/** The elements are copied to a buffer, reused for every chunk, so a span is valid
+ *  until the iterator is incremented. */
+template <typename R>
+class Chunk : public detail::AdaptorBase {
+   public:
+    using element_type = std::remove_cvref_t<detail::SourceReference<R>>;
+    using reference = std::span<element_type const>;
+
+    class Iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = reference;
+
+        auto operator*() const -> reference
+        {
+            return {buffer_->data(), buffer_->size()};
+        }
+
+        auto operator++() -> Iterator&
+        {
+            fill();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        auto operator==(std::default_sentinel_t) const -> bool
+        {
+            return buffer_->empty();
+        }
+
+       private:
+        friend Chunk;
+
+        Iterator(detail::SourcePosition<R> pos, std::size_t size)
+            : pos_{std::move(pos)},
+              size_{size},
+              buffer_{std::make_unique<std::vector<element_type>>()}
+        {
+            buffer_->reserve(size_);
+            fill();
+        }
+
+        void fill()
+        {
+            buffer_->clear();
+            while (buffer_->size() < size_ && !pos_.done()) {
+                buffer_->push_back(*pos_.it);
+                ++pos_.it;
+            }
+        }
+
+        detail::SourcePosition<R> pos_;
+        std::size_t size_;
+        // Boxed so that moving the iterator keeps handed out spans valid.
+        std::unique_ptr<std::vector<element_type>> buffer_;
+    };
+
+   public:
+    Chunk(R&& range, std::size_t size)
+        : source_{std::forward<R>(range)}, size_{std::max<std::size_t>(size, 1)}
+    {}
+
+    [[nodiscard]] auto begin() const -> Iterator
+    {
+        return {{source_.begin(), source_.end()}, size_};
+    }
+
+    [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+   private:
+    detail::AdaptorSource<R> source_;
+    std::size_t size_;
+};
+
+/// Range of pairs of the elements of two ranges, as long as the shorter, see zzz::zip.
+template <typename R1, typename R2>
+class Zip : public detail::AdaptorBase {
+   public:
+    using reference =
+        std::pair<detail::SourceReference<R1>, detail::SourceReference<R2>>;
+
+    class Iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        // The pair of references itself, std::pair has no common reference with a
+        // pair of values before C++23.
+        using value_type = reference;
+
+        auto operator*() const -> reference { return {*first_.it, *second_.it}; }
+
+        auto operator++() -> Iterator&
+        {
+            ++first_.it;
+            ++second_.it;
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        auto operator==(std::default_sentinel_t) const -> bool
+        {
+            return first_.done() || second_.done();
+        }
+
+       private:
+        friend Zip;
+
+        Iterator(detail::SourcePosition<R1> first, detail::SourcePosition<R2> second)
+            : first_{std::move(first)}, second_{std::move(second)}
+        {}
+
+        detail::SourcePosition<R1> first_;
+        detail::SourcePosition<R2> second_;
+    };
+
+   public:
+    Zip(R1&& first, R2&& second)
+        : first_{std::forward<R1>(first)}, second_{std::forward<R2>(second)}
+    {}
+
+    [[nodiscard]] auto begin() const -> Iterator
+    {
+        return {{first_.begin(), first_.end()}, {second_.begin(), second_.end()}};
+    }
+
+    [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+   private:
+    detail::AdaptorSource<R1> first_;
+    detail::AdaptorSource<R2> second_;
+};
+
+/// Range of pairs of the index and the element of each element of a range, see
+/// zzz::enumerate.
+template <typename R>
+class Enumerate : public detail::AdaptorBase {
+   public:
+    using reference = std::pair<std::size_t, detail::SourceReference<R>>;
+
+    class Iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        // As for Zip.
+        using value_type = reference;
+
+        auto operator*() const -> reference { return {index_, *pos_.it}; }
+
+        auto operator++() -> Iterator&
+        {
+            ++pos_.it;
+            ++index_;
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        auto operator==(std::default_sentinel_t) const -> bool { return pos_.done(); }
+
+       private:
+        friend Enumerate;
+
+        explicit Iterator(detail::SourcePosition<R> pos) : pos_{std::move(pos)} {}
+
+        detail::SourcePosition<R> pos_;
+        std::size_t index_{0};
+    };
+
+   public:
+    explicit Enumerate(R&& range) : source_{std::forward<R>(range)} {}
+
+    [[nodiscard]] auto begin() const -> Iterator
+    {
+        return Iterator{{source_.begin(), source_.end()}};
+    }
+
+    [[nodiscard]] auto end() const noexcept -> std::default_sentinel_t { return {}; }
+
+   private:
+    detail::AdaptorSource<R> source_;
+};
+
+/// Return a range of \p fn(x) for each x of \p range, computed as it is iterated.
+/** \p range is referenced if it is an lvalue, moved into the adaptor otherwise. */
+template <std::ranges::input_range R, typename F>
+[[nodiscard]] auto map(R&& range, F fn) -> Map<R, F>
+{
+    return {std::forward<R>(range), std::move(fn)};
+}
+
+/// Partial application of map, `range | map(fn)`.
+template <typename F>
+[[nodiscard]] auto map(F fn)
+{
+    return detail::make_closure([fn = std::move(fn)]<typename R>(R&& range) {
+        return map(std::forward<R>(range), fn);
+    });
+}
+
+/// Return a range of the elements x of \p range for which \p pred(x) is true.
+template <std::ranges::input_range R, typename P>
+[[nodiscard]] auto filter(R&& range, P pred) -> Filter<R, P>
+{
+    return {std::forward<R>(range), std::move(pred)};
+}
+
+/// Partial application of filter, `range | filter(pred)`.
+template <typename P>
+[[nodiscard]] auto filter(P pred)
+{
+    return detail::make_closure([pred = std::move(pred)]<typename R>(R&& range) {
+        return filter(std::forward<R>(range), pred);
+    });
+}
+
+/// Return a range of the first \p count elements of \p range, fewer if it is shorter.
+template <std::ranges::input_range R>
+[[nodiscard]] auto take(R&& range, std::size_t count) -> Take<R>
+{
+    return {std::forward<R>(range), count};
+}
+
+/// Partial application of take, `range | take(count)`.
+[[nodiscard]] inline auto take(std::size_t count)
+{
+    return detail::make_closure([count]<typename R>(R&& range) {
+        return take(std::forward<R>(range), count);
+    });
+}
+
+/// Return a range of spans of \p size consecutive elements of \p range, the last one
+/// shorter if the elements don't divide evenly. A \p size of 0 is taken as 1.
+template <std::ranges::input_range R>
+[[nodiscard]] auto chunk(R&& range, std::size_t size) -> Chunk<R>
+{
+    return {std::forward<R>(range), size};
+}
+
+/// Partial application of chunk, `range | chunk(size)`.
+[[nodiscard]] inline auto chunk(std::size_t size)
+{
+    return detail::make_closure([size]<typename R>(R&& range) {
+        return chunk(std::forward<R>(range), size);
+    });
+}
+
+/// Return a range of pairs of the i-th elements of \p first and \p second, until
+/// either ends.
+template <std::ranges::input_range R1, std::ranges::input_range R2>
+[[nodiscard]] auto zip(R1&& first, R2&& second) -> Zip<R1, R2>
+{
+    return {std::forward<R1>(first), std::forward<R2>(second)};
+}
+
+/// Partial application of zip, `first | zip(second)`.
+template <std::ranges::input_range R2>
+[[nodiscard]] auto zip(R2&& second)
+{
+    // Moved into the closure if an rvalue, referenced otherwise.
+    auto source = detail::AdaptorSource<R2>{std::forward<R2>(second)};
+    return detail::make_closure(
+        [source = std::move(source)]<typename R1>(R1&& first) mutable {
+            return zip(std::forward<R1>(first), std::move(source));
+        });
+}
+
+/// Return a range of pairs of the index and the element, for each element of \p range.
+template <std::ranges::input_range R>
+[[nodiscard]] auto enumerate(R&& range) -> Enumerate<R>
+{
+    return Enumerate<R>{std::forward<R>(range)};
+}
+
+/// Partial application of enumerate, `range | enumerate()`.
+[[nodiscard]] inline auto enumerate()
+{
+    return detail::make_closure(
+        []<typename R>(R&& range) { return enumerate(std::forward<R>(range)); });
+}
+
+}  // namespace zzz
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "./coro.hpp"
+
+namespace zzz {
+
+/**
+ * @brief Generator coroutine that may co_await, e.g. a Task or a Scheduler, between
+ * the values it yields.
+ * @details The consumer, itself a coroutine, awaits each value:
+ *
+ *     for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) { ... }
+ *
+ * or a batch of values at a time with `co_await gen.next()`, which returns a span,
+ * empty once the generator is done. Besides single values, the generator may yield a
+ * `std::span<T>`, or `elements_of` a contiguous range, to hand over many values with
+ * one resume. The values must stay alive until the consumer resumes the generator,
+ * as with Generator. Iterating a batch doesn't resume the generator, so per element
+ * it costs about as much as iterating a Generator.
+ *
+ * The generator resumes the consumer by symmetric transfer, on whatever thread the
+ * generator is running on at the time. Exceptions that escape the generator are
+ * rethrown from the consumer's co_await.
+ */
+template <typename T>
+class AsyncGenerator {
+   public:
+    using value_type = std::remove_cvref_t<T>;
+    using reference = std::remove_reference_t<T>&;
+    using batch_type = std::span<std::remove_reference_t<T>>;
+
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    struct promise_type {
+        /// Returns control to the consumer, unless the batch is empty.
+        struct YieldAwaiter {
+            auto await_ready() const noexcept -> bool { return empty; }
+
+            auto await_suspend(handle_type handle) noexcept -> std::coroutine_handle<>
+            {
+                return handle.promise().consumer_;
+            }
+
+            void await_resume() const noexcept {}
+
+            bool empty;
+        };
+
+        auto get_return_object()
+        {
+            return AsyncGenerator{handle_type::from_promise(*this)};
+        }
+
+        auto initial_suspend() noexcept { return std::suspend_always{}; }
+
+        auto final_suspend() noexcept { return YieldAwaiter{false}; }
+
+        auto yield_value(std::remove_reference_t<T>& value) noexcept -> YieldAwaiter
+        {
+            return yield_value(batch_type{std::addressof(value), 1});
+        }
+
+        auto yield_value(std::remove_reference_t<T>&& value) noexcept -> YieldAwaiter
+        {
+            return yield_value(batch_type{std::addressof(value), 1});
+        }
+
+        /// Yield every value of \p batch with a single resume of the consumer.
+        auto yield_value(batch_type batch) noexcept -> YieldAwaiter
+        {
+            batch_ = batch;
+            return YieldAwaiter{batch.empty()};
+        }
+
+        /// Yield the contiguous range of \p elements as one batch.
+        template <typename R>
+            requires std::ranges::contiguous_range<R> &&
+                     std::convertible_to<R&, batch_type>
+        auto yield_value(ElementsOf<R> elements) noexcept -> YieldAwaiter
+        {
+            return yield_value(batch_type{elements.range});
+        }
+
+        void return_void() noexcept { batch_ = {}; }
+
+        void unhandled_exception() noexcept
+        {
+            batch_ = {};
+            exception_ = std::current_exception();
+        }
+
+        [[nodiscard]] static auto operator new(std::size_t size) -> void*
+        {
+            return detail::allocate_frame(size);
+        }
+
+        static void operator delete(void* frame, std::size_t size) noexcept
+        {
+            detail::deallocate_frame(frame, size);
+        }
+
+        batch_type batch_;
+        std::exception_ptr exception_{nullptr};
+        std::coroutine_handle<> consumer_{nullptr};
+    };
+
+    /// Resumes the generator, returns the next batch; an empty one once it is done.
+    struct NextAwaiter {
+        auto await_ready() const noexcept -> bool { return !handle || handle.done(); }
+
+        auto await_suspend(std::coroutine_handle<> consumer) noexcept
+            -> std::coroutine_handle<>
+        {
+            handle.promise().consumer_ = consumer;
+            return handle;
+        }
+
+        auto await_resume() const -> batch_type
+        {
+            if (!handle) { return {}; }
+            auto& promise = handle.promise();
+            if (promise.exception_) {
+                std::rethrow_exception(std::exchange(promise.exception_, nullptr));
+            }
+            return promise.batch_;
+        }
+
+        handle_type handle;
+    };
+
+    class Iterator {
+       public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = AsyncGenerator::value_type;
+        using reference = AsyncGenerator::reference;
+        using pointer = std::remove_reference_t<T>*;
+
+        /// Moves the iterator to the next value, resuming the generator at the end
+        /// of a batch.
+        struct IncrementAwaiter {
+            auto await_ready() const noexcept -> bool
+            {
+                return ++it.index_ < it.batch_.size();
+            }
+
+            auto await_suspend(std::coroutine_handle<> consumer) noexcept
+                -> std::coroutine_handle<>
+            {
+                return NextAwaiter{it.handle_}.await_suspend(consumer);
+            }
+
+            auto await_resume() -> Iterator&
+            {
+                if (it.index_ >= it.batch_.size()) {
+                    it = Iterator{it.handle_, NextAwaiter{it.handle_}.await_resume()};
+                }
+                return it;
+            }
+
+            Iterator& it;
+        };
+
+        Iterator() noexcept = default;
+
+        Iterator(handle_type handle, batch_type batch) noexcept
+            : handle_{batch.empty() ? nullptr : handle}, batch_{batch}
+        {}
+
+        /// Return an awaitable that advances the iterator and returns it.
+        [[nodiscard]] auto operator++() noexcept -> IncrementAwaiter { return {*this}; }
+
+        auto operator*() const noexcept -> reference { return batch_[index_]; }
+
+        auto operator->() const noexcept -> pointer { return std::addressof(**this); }
+
+        auto operator==(Iterator const& other) const noexcept -> bool
+        {
+            return handle_ == other.handle_ && (!handle_ || index_ == other.index_);
+        }
+
+       private:
+        handle_type handle_{nullptr};
+        batch_type batch_;
+        std::size_t index_{0};
+    };
+
+   public:
+    explicit AsyncGenerator(handle_type handle) noexcept : handle_{handle} {}
+
+    AsyncGenerator(AsyncGenerator const&) = delete;
+    auto operator=(AsyncGenerator const&) -> AsyncGenerator& = delete;
+
+    AsyncGenerator(AsyncGenerator&& other) noexcept
+        : handle_{std::exchange(other.handle_, nullptr)}
+    {}
+
+    auto operator=(AsyncGenerator&& other) noexcept -> AsyncGenerator&
+    {
+        if (this != &other) {
+            if (handle_) { handle_.destroy(); }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~AsyncGenerator()
+    {
+        if (handle_) { handle_.destroy(); }
+    }
+
+   public:
+    /// Return an awaitable that resumes the generator and returns the next batch of
+    /// values; an empty span once the generator is done.
+    [[nodiscard]] auto next() noexcept -> NextAwaiter { return {handle_}; }
+
+    /// Return an awaitable that starts the generator and returns an iterator to its
+    /// first value.
+    [[nodiscard]] auto begin() noexcept
+    {
+        struct BeginAwaiter : NextAwaiter {
+            auto await_resume() const -> Iterator
+            {
+                return Iterator{this->handle, NextAwaiter::await_resume()};
+            }
+        };
+        return BeginAwaiter{{handle_}};
+    }
+
+    [[nodiscard]] auto end() const noexcept -> Iterator { return Iterator{}; }
+
+   private:
+    handle_type handle_;
+};
+
+}  // namespace zzz
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace zzz {
+
+namespace detail {
+
+/// Uninitialized storage for one T of a ring buffer.
+template <typename T>
+struct RingStorage {
+    template <typename... Args>
+    void construct(Args&&... args)
+    {
+        ::new (static_cast<void*>(bytes)) T(std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] auto get() noexcept -> T&
+    {
+        return *std::launder(reinterpret_cast<T*>(bytes));
+    }
+
+    /// Move the value out and destroy it.
+    [[nodiscard]] auto take() -> T
+    {
+        auto& value = get();
+        auto result = T(std::move(value));
+        value.~T();
+        return result;
+    }
+
+    alignas(T) std::byte bytes[sizeof(T)];
+};
+
+/// Return \p capacity rounded up to a power of two, at least 2.
+[[nodiscard]] inline auto ring_capacity(std::size_t capacity) -> std::size_t
+{
+    return std::bit_ceil(std::max<std::size_t>(capacity, 2));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Bounded lock-free queue from one producer thread to one consumer thread.
+ * @details The values live in a ring buffer, between the count of values ever popped,
+ * written by the consumer, and the count ever pushed, written by the producer. The
+ * two counts are on separate cache lines, and each thread keeps its own copy of the
+ * other's count, which it only reloads when the queue looks full, or empty. So while
+ * the queue is neither, a push or pop touches no cache line the other thread writes.
+ *
+ * Batch pushes and pops move many values with one update of the counts.
+ */
+template <typename T>
+    requires std::is_nothrow_move_constructible_v<T>
+class SpscQueue {
+   public:
+    using value_type = T;
+
+   public:
+    /// Create an empty queue of \p capacity values, rounded up to a power of two.
+    explicit SpscQueue(std::size_t capacity)
+        : mask_{detail::ring_capacity(capacity) - 1},
+          values_{std::make_unique<detail::RingStorage<T>[]>(mask_ + 1)}
+    {}
+
+    SpscQueue(SpscQueue const&) = delete;
+    auto operator=(SpscQueue const&) -> SpscQueue& = delete;
+
+    ~SpscQueue()
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        for (auto i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+            slot(i).get().~T();
+        }
+    }
+
+   public:
+    /// Construct a value at the back from \p args, producer only; false if full.
+    template <typename... Args>
+    auto try_emplace(Args&&... args) -> bool
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) { return false; }
+        }
+        slot(tail).construct(std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Push \p value at the back, producer only; false if full.
+    auto try_push(T const& value) -> bool { return try_emplace(value); }
+
+    /// Push \p value at the back, producer only; false if full, then it isn't moved.
+    auto try_push(T&& value) -> bool { return try_emplace(std::move(value)); }
+
+    /// Move as many of \p values as fit to the back, in order, producer only.
+    /** @return The number of values moved, from the front of \p values */
+    auto try_push_batch(std::span<T> values) -> std::size_t
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        if (mask_ + 1 - (tail - head_cache_) < values.size()) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+        }
+        auto const count = std::min(values.size(), mask_ + 1 - (tail - head_cache_));
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            slot(tail + i).construct(std::move(values[i]));
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Pop the value at the front, consumer only; std::nullopt if empty.
+    [[nodiscard]] auto try_pop() -> std::optional<T>
+    {
+        auto const head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) { return std::nullopt; }
+        }
+        auto result = std::optional<T>{slot(head).take()};
+        head_.store(head + 1, std::memory_order_release);
+        return result;
+    }
+
+    /// Move as many values as there are, up to the size of \p out, from the front to
+    /// \p out, consumer only.
+    /** @return The number of values moved, to the front of \p out */
+    auto try_pop_batch(std::span<T> out) -> std::size_t
+    {
+        auto const head = head_.load(std::memory_order_relaxed);
+        if (tail_cache_ - head < out.size()) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+        }
+        auto const count = std::min(out.size(), tail_cache_ - head);
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            out[i] = slot(head + i).take();
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /// Return the number of values, only a hint while other threads use the queue.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        auto const head = head_.load(std::memory_order_acquire);
+        auto const tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /// Return true if there are no values, only a hint while other threads use it.
+    [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+    /// Return the number of values the queue holds when full.
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t { return mask_ + 1; }
+
+   private:
+    [[nodiscard]] auto slot(std::size_t i) const noexcept -> detail::RingStorage<T>&
+    {
+        return values_[i & mask_];
+    }
+
+   private:
+    std::size_t mask_;
+    std::unique_ptr<detail::RingStorage<T>[]> values_;
+
+    // The consumer writes head and the producer tail, each with the copy of the
+    // other's it reads, keep them on separate cache lines.
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_{0};
+};
+
+/**
+ * @brief Bounded lock-free queue between any number of producer and consumer threads.
+ * @details Dmitry Vyukov's bounded MPMC queue: each slot of the ring buffer has a
+ * sequence number that says whether it is free for the push, or full for the pop, of
+ * a given position. Producers and consumers claim positions with a compare and swap
+ * on the push or pop count, each on its own cache line, and then only touch the slot
+ * they claimed. Slots are a cache line each, so that threads working on neighbouring
+ * slots don't contend.
+ *
+ * A batch push or pop claims a run of consecutive ready slots with one compare and
+ * swap.
+ */
+template <typename T>
+    requires std::is_nothrow_move_constructible_v<T>
+class MpmcQueue {
+   public:
+    using value_type = T;
+
+   public:
+    /// Create an empty queue of \p capacity values, rounded up to a power of two.
+    explicit MpmcQueue(std::size_t capacity)
+        : mask_{detail::ring_capacity(capacity) - 1},
+          slots_{std::make_unique<Slot[]>(mask_ + 1)}
+    {
+        for (auto i = std::size_t{0}; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(MpmcQueue const&) = delete;
+    auto operator=(MpmcQueue const&) -> MpmcQueue& = delete;
+
+    ~MpmcQueue()
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        for (auto i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+            slot(i).value.get().~T();
+        }
+    }
+
+   public:
+    /// Construct a value at the back from \p args; false if full.
+    /** If that may throw, the value is constructed before a slot is claimed, and then
+     *  moved, since a claimed slot left empty would block the consumers. */
+    template <typename... Args>
+    auto try_emplace(Args&&... args) -> bool
+    {
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+            auto const tail = claim(tail_, 0, 1);
+            if (tail.count == 0) { return false; }
+            auto& target = slot(tail.first);
+            target.value.construct(std::forward<Args>(args)...);
+            target.sequence.store(tail.first + 1, std::memory_order_release);
+            return true;
+        }
+        else {
+            auto value = T(std::forward<Args>(args)...);
+            return try_emplace(std::move(value));
+        }
+    }
+
+    /// Push \p value at the back; false if full.
+    auto try_push(T const& value) -> bool { return try_emplace(value); }
+
+    /// Push \p value at the back; false if full, then it isn't moved.
+    auto try_push(T&& value) -> bool { return try_emplace(std::move(value)); }
+
+    /// Move as many of \p values as there are free slots in a row to the back.
+    /** @return The number of values moved, from the front of \p values */
+    auto try_push_batch(std::span<T> values) -> std::size_t
+    {
+        if (values.empty()) { return 0; }
+        auto const tail = claim(tail_, 0, values.size());
+        for (auto i = std::size_t{0}; i < tail.count; ++i) {
+            auto& target = slot(tail.first + i);
+            target.value.construct(std::move(values[i]));
+            target.sequence.store(tail.first + i + 1, std::memory_order_release);
+        }
+        return tail.count;
+    }
+
+    /// Pop the value at the front; std::nullopt if empty.
+    [[nodiscard]] auto try_pop() -> std::optional<T>
+    {
+        auto const head = claim(head_, 1, 1);
+        if (head.count == 0) { return std::nullopt; }
+        return std::optional<T>{release(head.first)};
+    }
+
+    /// Move as many values as there are ready in a row, up to the size of \p out,
+    /// from the front to \p out.
+    /** @return The number of values moved, to the front of \p out */
+    auto try_pop_batch(std::span<T> out) -> std::size_t
+    {
+        if (out.empty()) { return 0; }
+        auto const head = claim(head_, 1, out.size());
+        for (auto i = std::size_t{0}; i < head.count; ++i) {
+            out[i] = release(head.first + i);
+        }
+        return head.count;
+    }
+
+    /// Return the number of values, only a hint while other threads use the queue.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        auto const head = head_.load(std::memory_order_acquire);
+        auto const tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /// Return true if there are no values, only a hint while other threads use it.
+    [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+    /// Return the number of values the queue holds when full.
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t { return mask_ + 1; }
+
+   private:
+    struct alignas(64) Slot {
+        /// The position this slot is free for the push of, or plus one, full for the
+        /// pop of.
+        std::atomic<std::size_t> sequence;
+        detail::RingStorage<T> value;
+    };
+
+    /// Positions [first, first + count) claimed by a push or pop.
+    struct Claim {
+        std::size_t first;
+        std::size_t count;
+    };
+
+    [[nodiscard]] auto slot(std::size_t i) const noexcept -> Slot&
+    {
+        return slots_[i & mask_];
+    }
+
+    /**
+     * Claim up to \p max positions from \p position on, whose slots are ready.
+     * @param position The push count, or the pop count
+     * @param ready The sequence of a slot ready at position i is i + \p ready
+     * @return The claimed positions, none if the first slot isn't ready
+     */
+    auto claim(std::atomic<std::size_t>& position, std::size_t ready, std::size_t max)
+        -> Claim
+    {
+        auto first = position.load(std::memory_order_relaxed);
+        while (true) {
+            auto count = std::size_t{0};
+            while (count < max) {
+                auto const sequence =
+                    slot(first + count).sequence.load(std::memory_order_acquire);
+                if (sequence != first + count + ready) { break; }
+                ++count;
+            }
+            if (count == 0) {
+                // Not ready, unless another thread claimed the position meanwhile.
+                auto const current = position.load(std::memory_order_relaxed);
+                if (current == first) { return {first, 0}; }
+                first = current;
+                continue;
+            }
+            if (position.compare_exchange_weak(
+                    first, first + count, std::memory_order_relaxed)) {
+                return {first, count};
+            }
+        }
+    }
+
+    /// Move out the value at \p position, claimed by a pop, and free its slot.
+    auto release(std::size_t position) -> T
+    {
+        auto& source = slot(position);
+        auto result = source.value.take();
+        source.sequence.store(position + mask_ + 1, std::memory_order_release);
+        return result;
+    }
+
+   private:
+    std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Producers write tail and consumers head, keep them on separate cache lines.
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+}  // namespace zzz
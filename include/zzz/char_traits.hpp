@@ -1,39 +1,154 @@
 #pragma once
-#include <cctype>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#include "./simd.hpp"
+
+/**
+ * @brief Character classification with the rules of the "C" locale.
+ * @details Each predicate is a lookup into a compile time table, bytes outside of
+ * ASCII belong to no class.
+ */
 
 namespace zzz {
+namespace detail {
+
+/// Bit flags for each character class in char_class_table.
+enum CharClass : std::uint16_t {
+    Whitespace = 1 << 0,
+    Alphabetic = 1 << 1,
+    Digit = 1 << 2,
+    HexidecimalDigit = 1 << 3,
+    Control = 1 << 4,
+    Graphical = 1 << 5,
+    Blank = 1 << 6,
+    Lowercase = 1 << 7,
+    Uppercase = 1 << 8,
+    Punctuation = 1 << 9,
+    Printable = 1 << 10,
+};
 
-[[nodiscard]] inline auto is_whitespace(char c) -> bool { return std::isspace(c) != 0; }
+/// CharClass flags of each byte value.
+inline constexpr auto char_class_table = [] {
+    auto table = std::array<std::uint16_t, 256>{};
+    for (auto i = 0; i < 128; ++i) {
+        auto const c = static_cast<char>(i);
+        auto flags = 0;
+        auto const lower = c >= 'a' && c <= 'z';
+        auto const upper = c >= 'A' && c <= 'Z';
+        auto const digit = c >= '0' && c <= '9';
+        auto const graphical = i > 32 && i < 127;
+        if (is_ascii_whitespace(c)) { flags |= Whitespace; }
+        if (lower || upper) { flags |= Alphabetic; }
+        if (digit) { flags |= Digit; }
+        if (digit || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')) {
+            flags |= HexidecimalDigit;
+        }
+        if (i < 32 || i == 127) { flags |= Control; }
+        if (graphical) { flags |= Graphical; }
+        if (c == ' ' || c == '\t') { flags |= Blank; }
+        if (lower) { flags |= Lowercase; }
+        if (upper) { flags |= Uppercase; }
+        if (graphical && !lower && !upper && !digit) { flags |= Punctuation; }
+        if (graphical || c == ' ') { flags |= Printable; }
+        table[static_cast<std::size_t>(i)] = static_cast<std::uint16_t>(flags);
+    }
+    return table;
+}();
 
-[[nodiscard]] inline auto is_alphabetic(char c) -> bool { return std::isalpha(c) != 0; }
+/// Return true if \p c belongs to any of the classes in \p mask.
+[[nodiscard]] constexpr auto has_class(char c, std::uint16_t mask) noexcept -> bool
+{
+    return (char_class_table[static_cast<unsigned char>(c)] & mask) != 0;
+}
 
-[[nodiscard]] inline auto is_digit(char c) -> bool { return std::isdigit(c) != 0; }
+}  // namespace detail
 
-[[nodiscard]] inline auto is_hexidecimal_digit(char c) -> bool
+[[nodiscard]] constexpr auto is_whitespace(char c) noexcept -> bool
 {
-    return std::isxdigit(c) != 0;
+    return detail::has_class(c, detail::Whitespace);
 }
 
-[[nodiscard]] inline auto is_control(char c) -> bool { return std::iscntrl(c) != 0; }
+[[nodiscard]] constexpr auto is_alphabetic(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::Alphabetic);
+}
+
+[[nodiscard]] constexpr auto is_digit(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::Digit);
+}
 
-[[nodiscard]] inline auto is_graphical(char c) -> bool { return std::isgraph(c) != 0; }
+[[nodiscard]] constexpr auto is_hexidecimal_digit(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::HexidecimalDigit);
+}
 
-[[nodiscard]] inline auto is_blank(char c) -> bool { return std::isblank(c) != 0; }
+[[nodiscard]] constexpr auto is_control(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::Control);
+}
 
-[[nodiscard]] inline auto is_alphanumeric(char c) -> bool
+[[nodiscard]] constexpr auto is_graphical(char c) noexcept -> bool
 {
-    return std::isalnum(c) != 0;
+    return detail::has_class(c, detail::Graphical);
 }
 
-[[nodiscard]] inline auto is_lowercase(char c) -> bool { return std::islower(c) != 0; }
+[[nodiscard]] constexpr auto is_blank(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::Blank);
+}
 
-[[nodiscard]] inline auto is_uppercase(char c) -> bool { return std::isupper(c) != 0; }
+[[nodiscard]] constexpr auto is_alphanumeric(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::Alphabetic | detail::Digit);
+}
 
-[[nodiscard]] inline auto is_punctuation(char c) -> bool
+[[nodiscard]] constexpr auto is_lowercase(char c) noexcept -> bool
 {
-    return std::ispunct(c) != 0;
+    return detail::has_class(c, detail::Lowercase);
 }
 
-[[nodiscard]] inline auto is_printable(char c) -> bool { return std::isprint(c) != 0; }
+[[nodiscard]] constexpr auto is_uppercase(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::Uppercase);
+}
+
+[[nodiscard]] constexpr auto is_punctuation(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::Punctuation);
+}
+
+[[nodiscard]] constexpr auto is_printable(char c) noexcept -> bool
+{
+    return detail::has_class(c, detail::Printable);
+}
+
+/// Return iterator to the first whitespace character in \p x; otherwise end iter.
+[[nodiscard]] inline auto find_first_whitespace(std::string_view x)
+    -> std::string_view::const_iterator
+{
+    auto const first = x.data();
+    auto const at = detail::find_whitespace(first, first + x.size(), false);
+    return std::next(std::cbegin(x), at - first);
+}
+
+/// Return iterator to the first non-whitespace character in \p x; otherwise end iter.
+[[nodiscard]] inline auto find_first_not_whitespace(std::string_view x)
+    -> std::string_view::const_iterator
+{
+    auto const first = x.data();
+    auto const at = detail::find_whitespace(first, first + x.size(), true);
+    return std::next(std::cbegin(x), at - first);
+}
+
+/// Return the number of digit characters in \p x.
+[[nodiscard]] inline auto count_digits(std::string_view x) -> std::size_t
+{
+    return detail::count_in_range(x.data(), x.data() + x.size(), '0', '9');
+}
 
-}  // namespace zzz
\ No newline at end of file
+}  // namespace zzz
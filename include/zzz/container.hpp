@@ -1,89 +1,289 @@
 #pragma once
 #include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
 #include <numeric>
 #include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
+#include "./search.hpp"
+#include "./simd.hpp"
+
 namespace zzz {
 
+namespace detail {
+
+/// Ranges the generic helpers accept, strings go to the std::string_view overloads
+/// instead so that string literals aren't searched up to their terminating null.
+template <typename R>
+concept NonStringRange = std::ranges::input_range<R const> &&
+                         !std::convertible_to<R const&, std::string_view>;
+
+/// Ranges whose elements can be pointed to, rather than yielded by value.
+template <typename R>
+concept LvalueRange =
+    std::is_lvalue_reference_v<std::ranges::range_reference_t<R const>>;
+
+/// True if find on \p R for a \p T can use the vectorized kernels on its memory.
+template <typename R, typename T>
+concept SimdSearchable =
+    std::ranges::contiguous_range<R const> && std::ranges::sized_range<R const> &&
+    SimdValue<std::ranges::range_value_t<R>> &&
+    std::same_as<std::ranges::range_value_t<R>, T>;
+
+}  // namespace detail
+
 /// Return true if \p x has no elements, false otherwise.
 template <typename Container>
 [[nodiscard]] auto is_empty(Container const& x) -> bool
 {
-    return x.empty();
+    return std::ranges::empty(x);
 }
 
 /// Return the first element of \p x; return std::nullopt if \p x is empty.
-template <template <typename...> typename Container, typename T>
-[[nodiscard]] auto head(Container<T> const& x) -> std::optional<T>
+template <std::ranges::forward_range R>
+[[nodiscard]] auto head(R const& x) -> std::optional<std::ranges::range_value_t<R>>
 {
-    return is_empty(x) ? std::nullopt : std::optional<T>{x.front()};
+    if (is_empty(x)) return std::nullopt;
+    return *std::ranges::begin(x);
 }
 
 /// Return the last element of \p x; return std::nullopt if \p x is empty.
-template <template <typename...> typename Container, typename T>
-[[nodiscard]] auto tail(Container<T> const& x) -> std::optional<T>
+template <std::ranges::bidirectional_range R>
+    requires std::ranges::common_range<R const>
+[[nodiscard]] auto tail(R const& x) -> std::optional<std::ranges::range_value_t<R>>
 {
-    return is_empty(x) ? std::nullopt : std::optional<T>{x.back()};
+    if (is_empty(x)) return std::nullopt;
+    return *std::ranges::prev(std::ranges::end(x));
 }
 
+/// Return pointer to the first element of \p x; return nullptr if \p x is empty.
+/** Does not copy the element, the pointer is valid as long as the element is. */
+template <std::ranges::forward_range R>
+    requires detail::LvalueRange<R>
+[[nodiscard]] auto head_ptr(R const& x)
+{
+    return is_empty(x) ? nullptr : std::addressof(*std::ranges::begin(x));
+}
+
+/// Return pointer to the last element of \p x; return nullptr if \p x is empty.
+/** Does not copy the element, the pointer is valid as long as the element is. */
+template <std::ranges::bidirectional_range R>
+    requires std::ranges::common_range<R const> && detail::LvalueRange<R>
+[[nodiscard]] auto tail_ptr(R const& x)
+{
+    return is_empty(x) ? nullptr
+                       : std::addressof(*std::ranges::prev(std::ranges::end(x)));
+}
+
+namespace detail {
+
+/// Return x.find(key), converting \p key to the key type only if the map can't
+/// look it up as is, e.g. a std::string_view in a map without transparent lookup.
+template <typename Mappable, typename Key>
+[[nodiscard]] auto find_key(Mappable& x, Key const& key)
+{
+    if constexpr (requires { x.find(key); })
+        return x.find(key);
+    else
+        return x.find(typename std::remove_const_t<Mappable>::key_type{key});
+}
+
+/// Pointer to the mapped type of \p Mappable, const if \p Mappable is const.
+template <typename Mappable>
+using MappedPointer =
+    std::conditional_t<std::is_const_v<Mappable>,
+                       typename std::remove_const_t<Mappable>::mapped_type const*,
+                       typename Mappable::mapped_type*>;
+
+}  // namespace detail
+
 /// Return the value associated with \p key in \p x; return nullopt if not found
-template <template <typename...> typename Mappable, typename K, typename V>
-[[nodiscard]] auto lookup(Mappable<K, V> const& x, K const& key) -> std::optional<V>
+/** \p key may be of any type the map can find, without converting it when the map
+ *  supports heterogeneous lookup. */
+template <template <typename...> typename Mappable,
+          typename K,
+          typename V,
+          typename... Ts,
+          typename Key>
+[[nodiscard]] auto lookup(Mappable<K, V, Ts...> const& x, Key const& key)
+    -> std::optional<V>
 {
-    auto const at = x.find(key);
+    auto const at = detail::find_key(x, key);
     if (at == std::cend(x))
         return std::nullopt;
     else
         return at->second;
 }
 
+/// Return pointer to the value associated with \p key in \p x; nullptr if not found
+/** Does not copy the value, the pointer is valid until the element is erased. \p key
+ *  may be of any type the map can find, as with lookup. */
+template <typename Mappable, typename Key>
+[[nodiscard]] auto lookup_ptr(Mappable& x, Key const& key)
+    -> detail::MappedPointer<Mappable>
+{
+    auto const at = detail::find_key(x, key);
+    if (at == std::end(x))
+        return nullptr;
+    else
+        return std::addressof(at->second);
+}
+
+/// Write a pointer to the value associated with each of \p keys in \p x to \p out,
+/// nullptr for keys that are not found.
+/** Maps that can hash a key ahead of its lookup and prefetch where its probe starts,
+ *  such as zzz::FlatMap, hash each key once and prefetch upcoming keys while earlier
+ *  keys are looked up, so that their cache misses may overlap. Out of order
+ *  execution often overlaps those of independent finds already, so this is not
+ *  reliably faster than find. Other maps are looked up one key after another, as
+ *  with lookup_ptr. \p out smaller than \p keys throws std::runtime_error. */
+template <typename Mappable, std::ranges::random_access_range Keys>
+void lookup_batch(Mappable const& x,
+                  Keys const& keys,
+                  std::span<typename Mappable::mapped_type const*> out)
+{
+    auto const size = static_cast<std::size_t>(std::ranges::size(keys));
+    if (out.size() < size)
+        throw std::runtime_error{"zzz::lookup_batch(...) Output is too small."};
+
+    auto const first = std::ranges::begin(keys);
+    if constexpr (requires(std::uint64_t hash) {
+                      x.prefetch(x.hash_of(*first));
+                      x.find_hashed(*first, hash);
+                  }) {
+        // Far enough ahead for the prefetch to complete, near enough to stay cached.
+        constexpr auto distance = std::size_t{8};
+        auto hashes = std::array<std::uint64_t, distance>{};
+
+        auto const prefetch = [&](std::size_t i) {
+            auto const hash = x.hash_of(first[i]);
+            hashes[i % distance] = hash;
+            x.prefetch(hash);
+        };
+
+        for (auto i = std::size_t{0}; i < std::min(distance, size); ++i) {
+            prefetch(i);
+        }
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            auto const at = x.find_hashed(first[i], hashes[i % distance]);
+            out[i] = at == x.end() ? nullptr : std::addressof(at->second);
+            if (i + distance < size) { prefetch(i + distance); }
+        }
+    }
+    else {
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            out[i] = lookup_ptr(x, first[i]);
+        }
+    }
+}
+
 /// Return iterator to first occurance of \p y in \p x; otherwise end iter.
 [[nodiscard]] inline auto find(std::string_view x, char y)
     -> std::string_view::const_iterator
 {
-    return std::find(std::cbegin(x), std::cend(x), y);
+    auto const first = x.data();
+    auto const at = detail::find_byte(first, first + x.size(), y);
+    return std::next(std::cbegin(x), at - first);
 }
 
 /// Return iterator to first occurance of \p segment in \p x; otherwise end iter
 [[nodiscard]] inline auto find(std::string_view x, std::string_view segment)
     -> std::string_view::const_iterator
 {
-    return std::search(std::cbegin(x), std::cend(x), std::cbegin(segment),
-                       std::cend(segment));
+    return Searcher{segment}(x);
+}
+
+/// Return iterator to first match of \p searcher in \p x; otherwise end iter.
+[[nodiscard]] inline auto find(std::string_view x, Searcher const& searcher)
+    -> std::string_view::const_iterator
+{
+    return searcher(x);
 }
 
 /// Return iterator to first occurance of \p y in \p x; otherwise end iter.
-template <typename T>
-[[nodiscard]] auto find(std::vector<T> const& x, T const& y) ->
-    typename std::vector<T>::const_iterator
+/** Contiguous ranges of arithmetic elements, e.g. std::vector or std::span, are
+ *  compared several elements at a time with SIMD. */
+template <std::ranges::forward_range R, typename T>
+    requires detail::NonStringRange<R> &&
+             std::equality_comparable_with<std::ranges::range_reference_t<R const>,
+                                           T const&>
+[[nodiscard]] auto find(R const& x, T const& y) -> std::ranges::iterator_t<R const>
+{
+    if constexpr (detail::SimdSearchable<R, T>) {
+        auto const first = std::ranges::data(x);
+        auto const at = detail::find_value(first, first + std::ranges::size(x), y);
+        return std::ranges::next(std::ranges::begin(x), at - first);
+    }
+    else {
+        return std::ranges::find(x, y);
+    }
+}
+
+/// Return a bitmap of the occurances of \p y in \p x, bit i % 64 of word i / 64 is
+/// set if the i-th element equals \p y.
+/** Contiguous ranges of arithmetic elements are compared several elements at a time
+ *  with SIMD. */
+template <std::ranges::forward_range R, typename T>
+    requires detail::NonStringRange<R> &&
+             std::equality_comparable_with<std::ranges::range_reference_t<R const>,
+                                           T const&>
+[[nodiscard]] auto find_all(R const& x, T const& y) -> std::vector<std::uint64_t>
 {
-    return std::find(std::cbegin(x), std::cend(x), y);
+    auto bits = std::vector<std::uint64_t>{};
+    if constexpr (detail::SimdSearchable<R, T>) {
+        auto const size = static_cast<std::size_t>(std::ranges::size(x));
+        bits.resize((size + 63) / 64);
+        detail::find_all_values(std::ranges::data(x), size, y, bits.data());
+    }
+    else {
+        auto i = std::size_t{0};
+        for (auto const& element : x) {
+            if (i % 64 == 0) { bits.push_back(0); }
+            bits.back() |= static_cast<std::uint64_t>(element == y) << (i % 64);
+            ++i;
+        }
+    }
+    return bits;
 }
 
 /// Return true if there is at least one occurance of \p y in \p x.
-template <typename T>
-[[nodiscard]] auto contains(std::vector<T> const& x, T const& y) -> bool
+template <std::ranges::forward_range R, typename T>
+    requires detail::NonStringRange<R> &&
+             std::equality_comparable_with<std::ranges::range_reference_t<R const>,
+                                           T const&> &&
+             (!requires(R const& x, T const& y) { x.contains(y); })
+[[nodiscard]] auto contains(R const& x, T const& y) -> bool
 {
-    return find(x, y) != std::cend(x);
+    return find(x, y) != std::ranges::end(x);
 }
 
-/// Apply result of F(U, T) to each element in \p x and return the result.
-template <typename F, typename T, typename U>
-[[nodiscard]] auto reduce(F&& func, U initial, std::vector<T> const& x) -> U
+/// Return true if \p x has an element with \p key, for sets and maps.
+template <typename Container, typename Key>
+    requires requires(Container const& x, Key const& key) { x.contains(key); }
+[[nodiscard]] auto contains(Container const& x, Key const& key) -> bool
 {
-    return std::accumulate(std::cbegin(x), std::cend(x), initial,
-                           std::forward<F>(func));
+    return x.contains(key);
 }
 
 /// Apply result of F(U, T) to each element in \p x and return the result.
-template <typename F, typename T, typename U, std::size_t N>
-[[nodiscard]] auto reduce(F&& func, U initial, std::array<T, N> const& x) -> U
+template <typename F, typename U, detail::NonStringRange R>
+[[nodiscard]] auto reduce(F&& func, U initial, R const& x) -> U
 {
-    return std::accumulate(std::cbegin(x), std::cend(x), initial,
-                           std::forward<F>(func));
+    for (auto const& element : x) {
+        initial = func(std::move(initial), element);
+    }
+    return initial;
 }
 
 /// Apply result of F(U, char) to each element in \p x and return the result.
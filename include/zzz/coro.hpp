@@ -1,16 +1,241 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <concepts>
 #include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <iterator>
 #include <memory>
+#include <new>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace zzz {
+namespace detail {
+
+/// Lifetime of the calling thread's FramePool, frames freed after it is destroyed,
+/// e.g. by thread_local or static destructors, go straight to operator delete.
+enum class FramePoolState : std::uint8_t { Unborn, Alive, Dead };
+
+inline thread_local auto frame_pool_state = FramePoolState::Unborn;
+
+/**
+ * @brief Thread local cache of coroutine frames, in power of two size classes.
+ * @details Freed frames are kept for reuse by the next coroutine of the same size
+ * class, so creating short lived generators in a loop doesn't call operator new
+ * after the first few. Each block is its own operator new allocation, so a frame may
+ * be freed on another thread than the one that allocated it. Frames larger than
+ * max_size are not cached.
+ */
+class FramePool {
+   public:
+    static constexpr std::size_t min_size = 64;
+    static constexpr std::size_t class_count = 7;
+    static constexpr std::size_t max_size = min_size << (class_count - 1);
+
+    /// Blocks kept per size class, further frees go to operator delete.
+    static constexpr std::size_t max_cached = 64;
+
+   public:
+    FramePool() noexcept { frame_pool_state = FramePoolState::Alive; }
+
+    FramePool(FramePool const&) = delete;
+    auto operator=(FramePool const&) -> FramePool& = delete;
+
+    ~FramePool()
+    {
+        frame_pool_state = FramePoolState::Dead;
+        for (auto block : free_) {
+            while (block != nullptr) {
+                ::operator delete(std::exchange(block, block->next));
+            }
+        }
+    }
+
+   public:
+    /// Return a block of at least \p size bytes.
+    [[nodiscard]] static auto allocate(std::size_t size) -> void*
+    {
+        if (size > max_size) { return ::operator new(size); }
+        auto const size_class = class_of(size);
+        if (auto const pool = local()) {
+            if (auto const block = pool->free_[size_class]) {
+                pool->free_[size_class] = block->next;
+                --pool->cached_[size_class];
+                return block;
+            }
+        }
+        return ::operator new(min_size << size_class);
+    }
+
+    /// Free \p block, returned by allocate(\p size).
+    static void deallocate(void* block, std::size_t size) noexcept
+    {
+        if (size <= max_size) {
+            auto const size_class = class_of(size);
+            auto const pool = local();
+            if (pool != nullptr && pool->cached_[size_class] < max_cached) {
+                auto& head = pool->free_[size_class];
+                head = ::new (block) FreeBlock{head};
+                ++pool->cached_[size_class];
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+   private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    [[nodiscard]] static constexpr auto class_of(std::size_t size) noexcept
+        -> std::size_t
+    {
+        return static_cast<std::size_t>(std::bit_width((size - 1) / min_size));
+    }
+
+    /// Return the calling thread's pool; nullptr once it is destroyed.
+    [[nodiscard]] static auto local() noexcept -> FramePool*
+    {
+        if (frame_pool_state == FramePoolState::Dead) { return nullptr; }
+        thread_local auto pool = FramePool{};
+        return &pool;
+    }
+
+   private:
+    std::array<FreeBlock*, class_count> free_{};
+    std::array<std::size_t, class_count> cached_{};
+};
+
+/// Frees a frame of the given size, stored after the frame so that operator delete
+/// can tell pooled frames from frames of a user allocator.
+using FrameDeallocate = void (*)(void* frame, std::size_t size) noexcept;
+
+[[nodiscard]] constexpr auto round_up(std::size_t size, std::size_t alignment) noexcept
+    -> std::size_t
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+/// Offset of the FrameDeallocate in a frame of \p size bytes.
+[[nodiscard]] constexpr auto deallocate_offset(std::size_t size) noexcept
+    -> std::size_t
+{
+    return round_up(size, alignof(FrameDeallocate));
+}
+
+/// Offset of the \p Alloc in a frame of \p size bytes.
+template <typename Alloc>
+[[nodiscard]] constexpr auto allocator_offset(std::size_t size) noexcept
+    -> std::size_t
+{
+    return round_up(deallocate_offset(size) + sizeof(FrameDeallocate), alignof(Alloc));
+}
+
+/// Unit frames of a user allocator are allocated in, aligned like operator new.
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) FrameChunk {
+    std::byte bytes[__STDCPP_DEFAULT_NEW_ALIGNMENT__];
+};
+
+template <typename Alloc>
+using FrameAllocator =
+    typename std::allocator_traits<Alloc>::template rebind_alloc<FrameChunk>;
+
+template <typename Alloc>
+[[nodiscard]] constexpr auto frame_chunks(std::size_t size) noexcept -> std::size_t
+{
+    auto const total = allocator_offset<FrameAllocator<Alloc>>(size) +
+                       sizeof(FrameAllocator<Alloc>);
+    return round_up(total, sizeof(FrameChunk)) / sizeof(FrameChunk);
+}
+
+inline void store_deallocate(void* frame, std::size_t size, FrameDeallocate fn) noexcept
+{
+    auto const at = static_cast<std::byte*>(frame) + deallocate_offset(size);
+    ::new (at) FrameDeallocate{fn};
+}
+
+inline void deallocate_pooled_frame(void* frame, std::size_t size) noexcept
+{
+    FramePool::deallocate(frame, deallocate_offset(size) + sizeof(FrameDeallocate));
+}
+
+template <typename Alloc>
+void deallocate_allocator_frame(void* frame, std::size_t size) noexcept
+{
+    auto const at =
+        static_cast<std::byte*>(frame) + allocator_offset<FrameAllocator<Alloc>>(size);
+    auto const stored = std::launder(reinterpret_cast<FrameAllocator<Alloc>*>(at));
+    auto alloc = std::move(*stored);
+    std::destroy_at(stored);
+    std::allocator_traits<FrameAllocator<Alloc>>::deallocate(
+        alloc, static_cast<FrameChunk*>(frame), frame_chunks<Alloc>(size));
+}
+
+/// Allocate a coroutine frame of \p size bytes from the thread local FramePool.
+[[nodiscard]] inline auto allocate_frame(std::size_t size) -> void*
+{
+    auto const frame =
+        FramePool::allocate(deallocate_offset(size) + sizeof(FrameDeallocate));
+    store_deallocate(frame, size, &deallocate_pooled_frame);
+    return frame;
+}
+
+/// Allocate a coroutine frame of \p size bytes with a copy of \p alloc, which is kept
+/// in the frame to free it.
+template <typename Alloc>
+[[nodiscard]] auto allocate_frame(std::size_t size, Alloc const& alloc) -> void*
+{
+    auto frame_alloc = FrameAllocator<Alloc>{alloc};
+    auto const frame = std::allocator_traits<FrameAllocator<Alloc>>::allocate(
+        frame_alloc, frame_chunks<Alloc>(size));
+    ::new (reinterpret_cast<std::byte*>(frame) +
+           allocator_offset<FrameAllocator<Alloc>>(size))
+        FrameAllocator<Alloc>{std::move(frame_alloc)};
+    store_deallocate(frame, size, &deallocate_allocator_frame<Alloc>);
+    return frame;
+}
+
+/// Free a coroutine frame of \p size bytes allocated by allocate_frame.
+inline void deallocate_frame(void* frame, std::size_t size) noexcept
+{
+    auto const fn = *std::launder(reinterpret_cast<FrameDeallocate*>(
+        static_cast<std::byte*>(frame) + deallocate_offset(size)));
+    fn(frame, size);
+}
+
+}  // namespace detail
+
+/// Wraps a range for `co_yield elements_of(range)`, see Generator.
+template <typename R>
+struct ElementsOf {
+    R range;
+};
+
+/// Yield every element of \p range from a Generator, `co_yield elements_of(range)`.
+/** \p range is referenced, not copied, it only has to outlive the co_yield. */
+template <typename R>
+[[nodiscard]] auto elements_of(R&& range) noexcept -> ElementsOf<R&&>
+{
+    return {std::forward<R>(range)};
+}
 
 /**
  * @brief Generator coroutine type that yields values of type T.
+ * @details Coroutine frames come from a thread local pool, see detail::FramePool. A
+ * generator taking std::allocator_arg_t and an allocator as its first parameters, or
+ * the first after the object parameter of a member function, allocates its frame
+ * with that allocator instead.
+ *
+ * `co_yield elements_of(generator)` yields everything the nested generator yields.
+ * The consumer resumes the innermost generator directly and control returns to the
+ * outer one by symmetric transfer when it finishes, so each element costs O(1)
+ * regardless of the nesting depth. Other ranges are yielded element by element.
  */
 template <typename T>
 class Generator {
@@ -23,29 +248,96 @@ class Generator {
         using reference_type = std::conditional_t<std::is_reference_v<T>, T, T&>;
         using pointer_type = value_type*;
 
+        /// Current value, only set on the outermost promise.
         pointer_type value_{nullptr};
         std::exception_ptr exception{nullptr};
 
-        auto get_return_object() { return Generator{handle_type::from_promise(*this)}; }
+        /// Outermost promise of a stack of nested generators, this if not nested.
+        promise_type* root_{this};
+
+        /// Generator that yielded this one with elements_of; nullptr if not nested.
+        std::coroutine_handle<> parent_{nullptr};
+
+        /// Innermost generator, the one to resume next, only set on the outermost.
+        std::coroutine_handle<> active_{nullptr};
+
+        /// Returns control to the parent when a nested generator finishes.
+        struct FinalAwaiter {
+            auto await_ready() noexcept -> bool { return false; }
+
+            auto await_suspend(handle_type handle) noexcept -> std::coroutine_handle<>
+            {
+                auto& promise = handle.promise();
+                if (!promise.parent_) { return std::noop_coroutine(); }
+                promise.root_->active_ = promise.parent_;
+                return promise.parent_;
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        /// Transfers control to a nested generator, rethrows what it didn't handle.
+        struct NestedAwaiter {
+            /// Owns the nested generator for ranges that aren't a Generator.
+            Generator owned_;
+            handle_type nested_;
+
+            auto await_ready() noexcept -> bool { return !nested_ || nested_.done(); }
+
+            auto await_suspend(handle_type handle) noexcept -> std::coroutine_handle<>
+            {
+                auto& nested = nested_.promise();
+                nested.root_ = handle.promise().root_;
+                nested.parent_ = handle;
+                nested.root_->active_ = nested_;
+                return nested_;
+            }
+
+            void await_resume()
+            {
+                if (nested_ && nested_.promise().exception) {
+                    std::rethrow_exception(nested_.promise().exception);
+                }
+            }
+        };
+
+        auto get_return_object()
+        {
+            active_ = handle_type::from_promise(*this);
+            return Generator{handle_type::from_promise(*this)};
+        }
 
         auto initial_suspend() noexcept { return std::suspend_always{}; }
 
-        auto final_suspend() noexcept { return std::suspend_always{}; }
+        auto final_suspend() noexcept { return FinalAwaiter{}; }
 
         template <typename U = T,
                   std::enable_if_t<!std::is_rvalue_reference_v<U>, int> = 0>
         auto yield_value(std::remove_reference_t<T>& v) noexcept
         {
-            value_ = std::addressof(v);
+            root_->value_ = std::addressof(v);
             return std::suspend_always{};
         }
 
         auto yield_value(std::remove_reference_t<T>&& v) noexcept
         {
-            value_ = std::addressof(v);
+            root_->value_ = std::addressof(v);
             return std::suspend_always{};
         }
 
+        template <typename R>
+        auto yield_value(ElementsOf<R> elements) -> NestedAwaiter
+        {
+            if constexpr (std::same_as<std::remove_cvref_t<R>, Generator>) {
+                return {Generator{handle_type{}}, elements.range.handle_};
+            }
+            else {
+                auto nested = yield_all<std::remove_reference_t<R>>(elements.range);
+                auto const handle = nested.handle_;
+                return {std::move(nested), handle};
+            }
+        }
+
         void return_void() noexcept {}
 
         void unhandled_exception() { exception = std::current_exception(); }
@@ -55,6 +347,53 @@ class Generator {
             return static_cast<reference_type>(*value_);
         }
 
+        [[nodiscard]] static auto operator new(std::size_t size) -> void*
+        {
+            return detail::allocate_frame(size);
+        }
+
+        // Inlined so that GCC doesn't pair the usual operator delete with a placement
+        // operator new and warn with -Wmismatched-new-delete.
+        template <typename Alloc, typename... Args>
+        [[nodiscard, gnu::always_inline]] static auto operator new(
+            std::size_t size,
+            std::allocator_arg_t,
+            Alloc const& alloc,
+            Args const&...) -> void*
+        {
+            return detail::allocate_frame(size, alloc);
+        }
+
+        template <typename This, typename Alloc, typename... Args>
+        [[nodiscard, gnu::always_inline]] static auto operator new(
+            std::size_t size,
+            This const&,
+            std::allocator_arg_t,
+            Alloc const& alloc,
+            Args const&...) -> void*
+        {
+            return detail::allocate_frame(size, alloc);
+        }
+
+        static void operator delete(void* frame, std::size_t size) noexcept
+        {
+            detail::deallocate_frame(frame, size);
+        }
+
+        /// Yield each element of \p range, for elements_of on ranges.
+        template <typename R>
+        static auto yield_all(R& range) -> Generator
+        {
+            for (auto&& x : range) {
+                if constexpr (std::is_convertible_v<decltype(x), value_type&>) {
+                    co_yield x;
+                }
+                else {
+                    co_yield static_cast<value_type>(x);
+                }
+            }
+        }
+
         // Don't allow any use of 'co_await' inside the generator coroutine
         template <typename U>
         std::suspend_never await_transform(U&&) = delete;
@@ -98,21 +437,12 @@ class Generator {
         IteratorBase() noexcept = default;
         explicit IteratorBase(handle_type handle) : handle_(handle)
         {
-            if (handle_) {
-                handle_.resume();
-                if (handle_.done()) { handle_ = nullptr; }
-            }
+            if (handle_) { this->advance(); }
         }
 
         auto operator++() -> IteratorBase&
         {
-            if (handle_ && !handle_.done()) {
-                handle_.resume();
-                if (handle_.done()) { handle_ = nullptr; }
-                else if (handle_.promise().exception) {
-                    std::rethrow_exception(handle_.promise().exception);
-                }
-            }
+            if (handle_ && !handle_.done()) { this->advance(); }
             return *this;
         }
 
@@ -143,6 +473,18 @@ class Generator {
             return !(*this == other);
         }
 
+       private:
+        /// Resume the innermost generator, rethrow what the outermost didn't handle.
+        void advance()
+        {
+            handle_.promise().active_.resume();
+            if (handle_.done()) {
+                auto const exception = handle_.promise().exception;
+                handle_ = nullptr;
+                if (exception) { std::rethrow_exception(exception); }
+            }
+        }
+
        private:
         handle_type handle_;
     };
@@ -0,0 +1,719 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./simd.hpp"
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#endif
+
+namespace zzz {
+namespace detail {
+
+/// Control byte of a slot that never held a value, ends a probe sequence.
+inline constexpr auto ctrl_empty = std::int8_t{-128};
+
+/// Control byte of a slot whose value was erased, probing continues past it.
+inline constexpr auto ctrl_deleted = std::int8_t{-2};
+
+/// Control bytes of an empty table, so lookups need no capacity check.
+alignas(16) inline constexpr std::int8_t empty_ctrl_group[16] = {
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty};
+
+/**
+ * @brief A window of 16 control bytes, matched all at once.
+ * @details Full slots store the low 7 bits of their hash, so a match narrows the
+ * candidates for a key to about one in 128 slots before any key is compared. Uses
+ * SSE2 when available, otherwise a portable loop.
+ */
+class ControlGroup {
+   public:
+    static constexpr std::size_t width = 16;
+
+   public:
+    explicit ControlGroup(std::int8_t const* ctrl) noexcept
+#if defined(__SSE2__)
+        : ctrl_{_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))}
+#else
+        : ctrl_{ctrl}
+#endif
+    {}
+
+   public:
+    /// Bitmask of the slots whose control byte is \p h2.
+    [[nodiscard]] auto match(std::int8_t h2) const noexcept -> std::uint32_t
+    {
+#if defined(__SSE2__)
+        return to_mask(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2)));
+#else
+        return this->match_if([h2](std::int8_t c) { return c == h2; });
+#endif
+    }
+
+    /// Bitmask of the empty slots.
+    [[nodiscard]] auto match_empty() const noexcept -> std::uint32_t
+    {
+        return this->match(ctrl_empty);
+    }
+
+    /// Bitmask of the slots that don't hold a value.
+    [[nodiscard]] auto match_empty_or_deleted() const noexcept -> std::uint32_t
+    {
+#if defined(__SSE2__)
+        // Both are below -1, full slots are not negative.
+        return to_mask(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_));
+#else
+        return this->match_if([](std::int8_t c) { return c < -1; });
+#endif
+    }
+
+   private:
+#if defined(__SSE2__)
+    [[nodiscard]] static auto to_mask(__m128i x) noexcept -> std::uint32_t
+    {
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(x));
+    }
+
+    __m128i ctrl_;
+#else
+    template <typename F>
+    [[nodiscard]] auto match_if(F const& predicate) const noexcept -> std::uint32_t
+    {
+        auto mask = std::uint32_t{0};
+        for (auto i = std::size_t{0}; i < width; ++i) {
+            mask |= static_cast<std::uint32_t>(predicate(ctrl_[i])) << i;
+        }
+        return mask;
+    }
+
+    std::int8_t const* ctrl_;
+#endif
+};
+
+}  // namespace detail
+
+/**
+ * @brief Open addressing hash map with SIMD probed control bytes.
+ * @details Swiss table layout: one control byte per slot, with 16 bytes probed per
+ * step, and values stored inline in one array, so most lookups touch two cache
+ * lines. Iterators and references are invalidated by any insertion that grows the
+ * table. Heterogeneous lookup is available when both \p Hash and \p KeyEqual define
+ * is_transparent. Growing moves the values but copies the keys, which are const.
+ */
+template <typename K,
+          typename V,
+          typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class FlatMap {
+   public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K const, V>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+    /// True if find and contains accept any key type \p Hash and \p KeyEqual accept.
+    static constexpr bool is_transparent = requires {
+        typename Hash::is_transparent;
+        typename KeyEqual::is_transparent;
+    };
+
+   private:
+    using Group = detail::ControlGroup;
+
+    /// Maximum load factor is 7/8, there is always an empty slot to end a probe.
+    [[nodiscard]] static constexpr auto max_size_for(std::size_t capacity) noexcept
+        -> std::size_t
+    {
+        return capacity - capacity / 8;
+    }
+
+   public:
+    template <bool IsConst>
+    class IteratorBase {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = FlatMap::value_type;
+        using reference = std::conditional_t<IsConst, value_type const&, value_type&>;
+        using pointer = std::conditional_t<IsConst, value_type const*, value_type*>;
+
+        IteratorBase() noexcept = default;
+
+        IteratorBase(std::int8_t const* ctrl,
+                     std::int8_t const* end,
+                     pointer slot) noexcept
+            : ctrl_{ctrl}, end_{end}, slot_{slot}
+        {
+            this->skip_empty();
+        }
+
+        /// Iterator to const from iterator.
+        template <bool OtherConst>
+            requires(IsConst && !OtherConst)
+        IteratorBase(IteratorBase<OtherConst> const& other) noexcept
+            : ctrl_{other.ctrl_}, end_{other.end_}, slot_{other.slot_}
+        {}
+
+        auto operator++() noexcept -> IteratorBase&
+        {
+            ++ctrl_;
+            ++slot_;
+            this->skip_empty();
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> IteratorBase
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        auto operator*() const noexcept -> reference { return *slot_; }
+
+        auto operator->() const noexcept -> pointer { return slot_; }
+
+        auto operator==(IteratorBase const& other) const noexcept -> bool
+        {
+            return slot_ == other.slot_;
+        }
+
+       private:
+        void skip_empty() noexcept
+        {
+            while (ctrl_ != end_ && *ctrl_ < 0) {
+                ++ctrl_;
+                ++slot_;
+            }
+        }
+
+       private:
+        template <bool>
+        friend class IteratorBase;
+
+        std::int8_t const* ctrl_{nullptr};
+        std::int8_t const* end_{nullptr};
+        pointer slot_{nullptr};
+    };
+
+    using Iterator = IteratorBase<false>;
+    using ConstIterator = IteratorBase<true>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+   public:
+    FlatMap() = default;
+
+    FlatMap(std::initializer_list<value_type> values)
+    {
+        this->reserve(values.size());
+        for (auto const& value : values) {
+            this->insert(value);
+        }
+    }
+
+    FlatMap(FlatMap const& other) : hash_{other.hash_}, equal_{other.equal_}
+    {
+        this->reserve(other.size());
+        for (auto const& value : other) {
+            this->insert(value);
+        }
+    }
+
+    FlatMap(FlatMap&& other) noexcept
+        : ctrl_{std::exchange(other.ctrl_, empty_ctrl())},
+          slots_{std::exchange(other.slots_, nullptr)},
+          capacity_{std::exchange(other.capacity_, 0)},
+          size_{std::exchange(other.size_, 0)},
+          growth_left_{std::exchange(other.growth_left_, 0)},
+          hash_{other.hash_},
+          equal_{other.equal_}
+    {}
+
+    auto operator=(FlatMap const& other) -> FlatMap&
+    {
+        if (this != &other) { *this = FlatMap{other}; }
+        return *this;
+    }
+
+    auto operator=(FlatMap&& other) noexcept -> FlatMap&
+    {
+        if (this != &other) {
+            this->release();
+            ctrl_ = std::exchange(other.ctrl_, empty_ctrl());
+            slots_ = std::exchange(other.slots_, nullptr);
+            capacity_ = std::exchange(other.capacity_, 0);
+            size_ = std::exchange(other.size_, 0);
+            growth_left_ = std::exchange(other.growth_left_, 0);
+            hash_ = other.hash_;
+            equal_ = other.equal_;
+        }
+        return *this;
+    }
+
+    ~FlatMap() { this->release(); }
+
+   public:
+    [[nodiscard]] auto begin() noexcept -> Iterator
+    {
+        return {ctrl_, ctrl_ + capacity_, slots_};
+    }
+    [[nodiscard]] auto begin() const noexcept -> ConstIterator
+    {
+        return {ctrl_, ctrl_ + capacity_, slots_};
+    }
+    [[nodiscard]] auto cbegin() const noexcept -> ConstIterator
+    {
+        return this->begin();
+    }
+
+    [[nodiscard]] auto end() noexcept -> Iterator
+    {
+        return this->iterator_at(capacity_);
+    }
+    [[nodiscard]] auto end() const noexcept -> ConstIterator
+    {
+        return this->iterator_at(capacity_);
+    }
+    [[nodiscard]] auto cend() const noexcept -> ConstIterator { return this->end(); }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+    /// Return the number of slots, the table grows when 7/8 of them are used.
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+   public:
+    /// Return iterator to the element with \p key; otherwise end iter.
+    [[nodiscard]] auto find(K const& key) -> Iterator
+    {
+        return this->iterator_at(this->find_index(key));
+    }
+
+    [[nodiscard]] auto find(K const& key) const -> ConstIterator
+    {
+        return this->iterator_at(this->find_index(key));
+    }
+
+    /// Heterogeneous find, \p key is hashed and compared without converting it.
+    template <typename Key>
+        requires(is_transparent && !std::same_as<Key, K>)
+    [[nodiscard]] auto find(Key const& key) -> Iterator
+    {
+        return this->iterator_at(this->find_index(key));
+    }
+
+    template <typename Key>
+        requires(is_transparent && !std::same_as<Key, K>)
+    [[nodiscard]] auto find(Key const& key) const -> ConstIterator
+    {
+        return this->iterator_at(this->find_index(key));
+    }
+
+    /// Return true if there is an element with \p key.
+    [[nodiscard]] auto contains(K const& key) const -> bool
+    {
+        return this->find_index(key) != capacity_;
+    }
+
+    template <typename Key>
+        requires(is_transparent && !std::same_as<Key, K>)
+    [[nodiscard]] auto contains(Key const& key) const -> bool
+    {
+        return this->find_index(key) != capacity_;
+    }
+
+    /// Return the value of the element with \p key, throws std::out_of_range if none.
+    [[nodiscard]] auto at(K const& key) -> V&
+    {
+        auto const at = this->find_index(key);
+        if (at == capacity_)
+            throw std::out_of_range{"zzz::FlatMap::at(...) No such key."};
+        return slots_[at].second;
+    }
+
+    [[nodiscard]] auto at(K const& key) const -> V const&
+    {
+        auto const at = this->find_index(key);
+        if (at == capacity_)
+            throw std::out_of_range{"zzz::FlatMap::at(...) No such key."};
+        return slots_[at].second;
+    }
+
+    /// Return the value of the element with \p key, inserting a default one if none.
+    auto operator[](K const& key) -> V& { return this->try_emplace(key).first->second; }
+
+    auto operator[](K&& key) -> V&
+    {
+        return this->try_emplace(std::move(key)).first->second;
+    }
+
+   public:
+    /// Insert an element with \p key and V constructed from \p args if there is none.
+    /** Return iterator to the element with \p key and true if it was inserted. */
+    template <typename... Args>
+    auto try_emplace(K const& key, Args&&... args) -> std::pair<Iterator, bool>
+    {
+        return this->emplace_key(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    auto try_emplace(K&& key, Args&&... args) -> std::pair<Iterator, bool>
+    {
+        return this->emplace_key(std::move(key), std::forward<Args>(args)...);
+    }
+
+    /// Heterogeneous try_emplace, \p key is converted only if it is inserted.
+    template <typename Key, typename... Args>
+        requires(is_transparent && !std::same_as<std::remove_cvref_t<Key>, K> &&
+                 std::constructible_from<K, Key &&>)
+    auto try_emplace(Key&& key, Args&&... args) -> std::pair<Iterator, bool>
+    {
+        return this->emplace_key(std::forward<Key>(key), std::forward<Args>(args)...);
+    }
+
+    /// Insert \p value if there is no element with its key.
+    auto insert(value_type const& value) -> std::pair<Iterator, bool>
+    {
+        return this->try_emplace(value.first, value.second);
+    }
+
+    auto insert(value_type&& value) -> std::pair<Iterator, bool>
+    {
+        return this->try_emplace(value.first, std::move(value.second));
+    }
+
+    /// Insert an element with \p key, or assign \p value to the existing one.
+    template <typename M>
+    auto insert_or_assign(K const& key, M&& value) -> std::pair<Iterator, bool>
+    {
+        // The value is only moved from if it is inserted.
+        auto result = this->try_emplace(key, std::forward<M>(value));
+        if (!result.second) { result.first->second = std::forward<M>(value); }
+        return result;
+    }
+
+    template <typename M>
+    auto insert_or_assign(K&& key, M&& value) -> std::pair<Iterator, bool>
+    {
+        auto result = this->try_emplace(std::move(key), std::forward<M>(value));
+        if (!result.second) { result.first->second = std::forward<M>(value); }
+        return result;
+    }
+
+    /// Erase the element at \p pos, return iterator to the element after it.
+    auto erase(ConstIterator pos) -> Iterator
+    {
+        auto const at = static_cast<std::size_t>(pos.operator->() - slots_);
+        this->erase_at(at);
+        return {ctrl_ + at, ctrl_ + capacity_, slots_ + at};
+    }
+
+    auto erase(Iterator pos) -> Iterator { return this->erase(ConstIterator{pos}); }
+
+    /// Erase the element with \p key, return the number of elements erased.
+    auto erase(K const& key) -> std::size_t
+    {
+        auto const at = this->find_index(key);
+        if (at == capacity_) { return 0; }
+        this->erase_at(at);
+        return 1;
+    }
+
+    /// Erase all elements, keeping the capacity.
+    void clear() noexcept
+    {
+        this->destroy_all();
+        if (capacity_ != 0) {
+            std::memset(ctrl_, detail::ctrl_empty, capacity_ + Group::width);
+        }
+        size_ = 0;
+        growth_left_ = max_size_for(capacity_);
+    }
+
+    /// Make room for at least \p count elements without growing again.
+    void reserve(std::size_t count)
+    {
+        auto capacity = std::max<std::size_t>(Group::width, capacity_);
+        while (max_size_for(capacity) < count) {
+            capacity *= 2;
+        }
+        if (capacity != capacity_) { this->resize(capacity); }
+    }
+
+    [[nodiscard]] auto hash_function() const -> Hash { return hash_; }
+
+    [[nodiscard]] auto key_eq() const -> KeyEqual { return equal_; }
+
+   public:
+    /// Hash \p key and mix the result, std::hash is the identity for integers.
+    /** The hash find_hashed and prefetch take, so a batch of lookups can hash each
+     *  key once, prefetch, and find it later. */
+    template <typename Key>
+        requires(std::same_as<Key, K> || is_transparent)
+    [[nodiscard]] auto hash_of(Key const& key) const -> std::uint64_t
+    {
+        auto const hash =
+            static_cast<std::uint64_t>(hash_(key)) * 0x9E37'79B9'7F4A'7C15u;
+        return hash ^ (hash >> 32);
+    }
+
+    /// Hint that a key of \p hash will be looked up soon, loading the control bytes
+    /// its probe starts at.
+    void prefetch(std::uint64_t hash) const noexcept
+    {
+        if (capacity_ == 0) { return; }
+        auto const pos = static_cast<std::size_t>(hash >> 7) & (capacity_ - 1);
+        detail::prefetch(ctrl_ + pos);
+    }
+
+    /// Return iterator to the element with \p key; otherwise end iter.
+    /** \p hash must be hash_of(\p key). */
+    template <typename Key>
+        requires(std::same_as<Key, K> || is_transparent)
+    [[nodiscard]] auto find_hashed(Key const& key, std::uint64_t hash) const
+        -> ConstIterator
+    {
+        return this->iterator_at(this->find_index(key, hash));
+    }
+
+   private:
+    [[nodiscard]] static auto empty_ctrl() noexcept -> std::int8_t*
+    {
+        // Never written to, a table with no capacity grows before inserting.
+        return const_cast<std::int8_t*>(detail::empty_ctrl_group);
+    }
+
+    [[nodiscard]] static auto h2(std::uint64_t hash) noexcept -> std::int8_t
+    {
+        return static_cast<std::int8_t>(hash & 0x7F);
+    }
+
+    [[nodiscard]] auto iterator_at(std::size_t at) noexcept -> Iterator
+    {
+        return {ctrl_ + at, ctrl_ + capacity_, slots_ + at};
+    }
+
+    [[nodiscard]] auto iterator_at(std::size_t at) const noexcept -> ConstIterator
+    {
+        return {ctrl_ + at, ctrl_ + capacity_, slots_ + at};
+    }
+
+    /// Return the slot index of \p key; otherwise capacity_.
+    template <typename Key>
+    [[nodiscard]] auto find_index(Key const& key) const -> std::size_t
+    {
+        return this->find_index(key, this->hash_of(key));
+    }
+
+    template <typename Key>
+    [[nodiscard]] auto find_index(Key const& key, std::uint64_t hash) const
+        -> std::size_t
+    {
+        auto const mask = capacity_ == 0 ? 0 : capacity_ - 1;
+        auto pos = static_cast<std::size_t>(hash >> 7) & mask;
+        auto step = std::size_t{0};
+        while (true) {
+            auto const group = Group{ctrl_ + pos};
+            for (auto match = group.match(h2(hash)); match != 0; match &= match - 1) {
+                auto const offset = static_cast<std::size_t>(std::countr_zero(match));
+                auto const at = (pos + offset) & mask;
+                if (equal_(slots_[at].first, key)) { return at; }
+            }
+            if (group.match_empty() != 0) { return capacity_; }
+
+            // Triangular probing visits every group once for power of two sizes.
+            step += Group::width;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    template <typename Key, typename... Args>
+    auto emplace_key(Key&& key, Args&&... args) -> std::pair<Iterator, bool>
+    {
+        auto const hash = this->hash_of(key);
+        if (auto const at = this->find_index(key, hash); at != capacity_) {
+            return {this->iterator_at(at), false};
+        }
+        auto const at = this->prepare_insert(hash);
+        std::construct_at(slots_ + at, std::piecewise_construct,
+                          std::forward_as_tuple(std::forward<Key>(key)),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+        this->finish_insert(at, hash);
+        return {this->iterator_at(at), true};
+    }
+
+    /// Return the first slot without a value on the probe sequence of \p hash.
+    [[nodiscard]] auto find_free_slot(std::uint64_t hash) const noexcept -> std::size_t
+    {
+        return find_free_slot(ctrl_, capacity_, hash);
+    }
+
+    /// Same, in the control bytes \p ctrl of a table with \p capacity slots.
+    [[nodiscard]] static auto find_free_slot(std::int8_t const* ctrl,
+                                             std::size_t capacity,
+                                             std::uint64_t hash) noexcept -> std::size_t
+    {
+        auto const mask = capacity - 1;
+        auto pos = static_cast<std::size_t>(hash >> 7) & mask;
+        auto step = std::size_t{0};
+        while (true) {
+            auto const free = Group{ctrl + pos}.match_empty_or_deleted();
+            if (free != 0) {
+                return (pos + static_cast<std::size_t>(std::countr_zero(free))) & mask;
+            }
+            step += Group::width;
+            pos = (pos + step) & mask;
+        }
+    }
+
+    /// Return the slot to insert an element with \p hash into, growing if needed.
+    [[nodiscard]] auto prepare_insert(std::uint64_t hash) -> std::size_t
+    {
+        if (growth_left_ == 0) {
+            // Mostly erased slots are reclaimed without growing.
+            auto const reclaim = capacity_ != 0 && size_ * 32 <= capacity_ * 25;
+            this->resize(reclaim ? capacity_ : std::max(capacity_ * 2, Group::width));
+        }
+        return this->find_free_slot(hash);
+    }
+
+    /// Mark the slot \p at, with a newly constructed value, as full.
+    void finish_insert(std::size_t at, std::uint64_t hash) noexcept
+    {
+        if (ctrl_[at] == detail::ctrl_empty) { --growth_left_; }
+        this->set_ctrl(at, h2(hash));
+        ++size_;
+    }
+
+    void erase_at(std::size_t at)
+    {
+        std::destroy_at(slots_ + at);
+        this->set_ctrl(at, detail::ctrl_deleted);
+        --size_;
+    }
+
+    /// The first group is cloned after the last slot, so groups can wrap around.
+    void set_ctrl(std::size_t at, std::int8_t value) noexcept
+    {
+        set_ctrl(ctrl_, capacity_, at, value);
+    }
+
+    /// Same, in the control bytes \p ctrl of a table with \p capacity slots.
+    static void set_ctrl(std::int8_t* ctrl,
+                         std::size_t capacity,
+                         std::size_t at,
+                         std::int8_t value) noexcept
+    {
+        ctrl[at] = value;
+        if (at < Group::width) { ctrl[capacity + at] = value; }
+    }
+
+    /// Move every element into a new table with \p capacity slots.
+    /** The new table is built aside, the elements are only moved into it once every
+     *  hash is known, and copied instead if their move may throw and they can be.
+     *  So the table is unchanged if anything throws, unless a move does. */
+    void resize(std::size_t capacity)
+    {
+        auto ctrl =
+            std::unique_ptr<std::int8_t[]>{new std::int8_t[capacity + Group::width]};
+        std::memset(ctrl.get(), detail::ctrl_empty, capacity + Group::width);
+
+        struct SlotsDeleter {
+            void operator()(value_type* slots) const noexcept
+            {
+                std::allocator<value_type>{}.deallocate(slots, capacity);
+            }
+            std::size_t capacity;
+        };
+        auto slots = std::unique_ptr<value_type[], SlotsDeleter>{
+            std::allocator<value_type>{}.allocate(capacity), SlotsDeleter{capacity}};
+
+        // Hashing may throw, so place every element before moving any.
+        auto targets = std::vector<std::size_t>(capacity_);
+        for (auto i = std::size_t{0}; i < capacity_; ++i) {
+            if (ctrl_[i] < 0) { continue; }
+            auto const hash = this->hash_of(slots_[i].first);
+            targets[i] = find_free_slot(ctrl.get(), capacity, hash);
+            set_ctrl(ctrl.get(), capacity, targets[i], h2(hash));
+        }
+
+        auto constructed = std::size_t{0};
+        try {
+            for (; constructed < capacity_; ++constructed) {
+                if (ctrl_[constructed] < 0) { continue; }
+                std::construct_at(slots.get() + targets[constructed],
+                                  std::move_if_noexcept(slots_[constructed]));
+            }
+        }
+        catch (...) {
+            for (auto i = std::size_t{0}; i < constructed; ++i) {
+                if (ctrl_[i] >= 0) { std::destroy_at(slots.get() + targets[i]); }
+            }
+            throw;
+        }
+
+        this->destroy_all();
+        if (capacity_ != 0) {
+            delete[] ctrl_;
+            std::allocator<value_type>{}.deallocate(slots_, capacity_);
+        }
+        ctrl_ = ctrl.release();
+        slots_ = slots.release();
+        capacity_ = capacity;
+        growth_left_ = max_size_for(capacity) - size_;
+    }
+
+    void destroy_all() noexcept
+    {
+        for (auto i = std::size_t{0}; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) { std::destroy_at(slots_ + i); }
+        }
+    }
+
+    void release() noexcept
+    {
+        this->destroy_all();
+        if (capacity_ != 0) {
+            delete[] ctrl_;
+            std::allocator<value_type>{}.deallocate(slots_, capacity_);
+        }
+        ctrl_ = empty_ctrl();
+        slots_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        growth_left_ = 0;
+    }
+
+   private:
+    std::int8_t* ctrl_{empty_ctrl()};
+    value_type* slots_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t size_{0};
+    std::size_t growth_left_{0};
+    [[no_unique_address]] Hash hash_{};
+    [[no_unique_address]] KeyEqual equal_{};
+};
+
+}  // namespace zzz
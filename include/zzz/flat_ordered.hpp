@@ -0,0 +1,507 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./simd.hpp"
+
+namespace zzz {
+namespace detail {
+
+/// Return the index of the first of the \p size sorted keys at \p first that is not
+/// less than \p key; otherwise \p size.
+/** The loop has a fixed trip count and no data dependent branch. Both possible next
+ *  probes are prefetched, which overlaps the cache misses of consecutive steps on
+ *  tables larger than the caches. */
+template <typename T, typename Key, typename Compare>
+[[nodiscard]] auto branchless_lower_bound(T const* first,
+                                          std::size_t size,
+                                          Key const& key,
+                                          Compare const& less) -> std::size_t
+{
+    if (size == 0) { return 0; }
+    auto base = first;
+    auto n = size;
+    while (n > 1) {
+        auto const half = n / 2;
+        prefetch(base + half / 2);
+        prefetch(base + half + half / 2);
+        // Arithmetic rather than a ternary, GCC turns the ternary into a branch.
+        base += static_cast<std::size_t>(less(base[half - 1], key)) * half;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - first) + less(*base, key);
+}
+
+/// Sort \p keys and drop every key equal to an earlier one.
+template <typename T, typename Compare>
+void sort_unique(std::vector<T>& keys, Compare const& less)
+{
+    std::stable_sort(keys.begin(), keys.end(), less);
+    auto const equal = [&](T const& a, T const& b) { return !less(a, b); };
+    keys.erase(std::unique(keys.begin(), keys.end(), equal), keys.end());
+}
+
+}  // namespace detail
+
+/**
+ * @brief Ordered set stored as a sorted vector.
+ * @details Built once from unsorted input, then looked up with a branchless binary
+ * search over contiguous keys. Inserting and erasing are linear, use it for tables
+ * that are read far more often than they are written. Heterogeneous lookup is
+ * available when \p Compare defines is_transparent.
+ */
+template <typename K, typename Compare = std::less<K>>
+class FlatSet {
+   public:
+    using key_type = K;
+    using value_type = K;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+    using const_iterator = typename std::vector<K>::const_iterator;
+    using iterator = const_iterator;
+
+    /// True if find and contains accept any key type \p Compare accepts.
+    static constexpr bool is_transparent = requires {
+        typename Compare::is_transparent;
+    };
+
+   public:
+    FlatSet() = default;
+
+    /// Build from \p keys in any order, sorted once; duplicates are dropped.
+    explicit FlatSet(std::vector<K> keys, Compare less = {})
+        : keys_{std::move(keys)}, less_{std::move(less)}
+    {
+        detail::sort_unique(keys_, less_);
+    }
+
+    FlatSet(std::initializer_list<K> keys, Compare less = {})
+        : FlatSet{std::vector<K>(keys), std::move(less)}
+    {}
+
+    template <std::input_iterator It>
+    FlatSet(It first, It last, Compare less = {})
+        : FlatSet{std::vector<K>(first, last), std::move(less)}
+    {}
+
+   public:
+    [[nodiscard]] auto begin() const noexcept -> const_iterator
+    {
+        return keys_.cbegin();
+    }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator { return keys_.cend(); }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return keys_.size(); }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return keys_.empty(); }
+
+    /// Return the keys in order.
+    [[nodiscard]] auto keys() const noexcept -> std::span<K const> { return keys_; }
+
+   public:
+    /// Return iterator to \p key; otherwise end iter.
+    [[nodiscard]] auto find(K const& key) const -> const_iterator
+    {
+        return this->begin() + static_cast<std::ptrdiff_t>(this->find_index(key));
+    }
+
+    template <typename Key>
+        requires(is_transparent && !std::same_as<Key, K>)
+    [[nodiscard]] auto find(Key const& key) const -> const_iterator
+    {
+        return this->begin() + static_cast<std::ptrdiff_t>(this->find_index(key));
+    }
+
+    /// Return true if \p key is in the set.
+    [[nodiscard]] auto contains(K const& key) const -> bool
+    {
+        return this->find_index(key) != keys_.size();
+    }
+
+    template <typename Key>
+        requires(is_transparent && !std::same_as<Key, K>)
+    [[nodiscard]] auto contains(Key const& key) const -> bool
+    {
+        return this->find_index(key) != keys_.size();
+    }
+
+    /// Return iterator to the first key not less than \p key; otherwise end iter.
+    [[nodiscard]] auto lower_bound(K const& key) const -> const_iterator
+    {
+        auto const at =
+            detail::branchless_lower_bound(keys_.data(), keys_.size(), key, less_);
+        return this->begin() + static_cast<std::ptrdiff_t>(at);
+    }
+
+   public:
+    /// Insert \p key if it is not in the set, linear in the size of the set.
+    /** Return iterator to \p key and true if it was inserted. */
+    auto insert(K key) -> std::pair<const_iterator, bool>
+    {
+        auto const at = this->lower_bound(key);
+        if (at != this->end() && !less_(key, *at)) { return {at, false}; }
+        return {keys_.insert(at, std::move(key)), true};
+    }
+
+    /// Erase \p key, return the number of keys erased.
+    auto erase(K const& key) -> std::size_t
+    {
+        auto const at = this->find_index(key);
+        if (at == keys_.size()) { return 0; }
+        keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(at));
+        return 1;
+    }
+
+   private:
+    /// Return the index of \p key; otherwise keys_.size().
+    template <typename Key>
+    [[nodiscard]] auto find_index(Key const& key) const -> std::size_t
+    {
+        auto const at =
+            detail::branchless_lower_bound(keys_.data(), keys_.size(), key, less_);
+        return at != keys_.size() && !less_(key, keys_[at]) ? at : keys_.size();
+    }
+
+   private:
+    std::vector<K> keys_;
+    [[no_unique_address]] Compare less_{};
+};
+
+/**
+ * @brief Ordered map stored as a sorted vector of keys and a parallel vector of
+ * values.
+ * @details Built once from unsorted input, then looked up with a branchless binary
+ * search that only touches the keys, so the values don't dilute the cache lines it
+ * reads. Inserting and erasing are linear, use it for tables that are read far more
+ * often than they are written. Iterators are random access and yield pairs of
+ * references to a key and its value. Heterogeneous lookup is available when
+ * \p Compare defines is_transparent.
+ */
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatOrderedMap {
+   public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = std::size_t;
+    using key_compare = Compare;
+
+    /// True if find and contains accept any key type \p Compare accepts.
+    static constexpr bool is_transparent = requires {
+        typename Compare::is_transparent;
+    };
+
+   public:
+    template <bool IsConst>
+    class IteratorBase {
+       public:
+        using iterator_category = std::random_access_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using mapped_pointer = std::conditional_t<IsConst, V const*, V*>;
+        using mapped_reference = std::conditional_t<IsConst, V const&, V&>;
+        using reference = std::pair<K const&, mapped_reference>;
+        // The pair of references itself, std::pair has no common reference with a
+        // pair of values before C++23.
+        using value_type = reference;
+
+        /// Lets it->second name the value, *it is not an lvalue.
+        struct Arrow {
+            reference ref;
+            auto operator->() noexcept -> reference* { return &ref; }
+        };
+        using pointer = Arrow;
+
+        IteratorBase() noexcept = default;
+
+        IteratorBase(K const* key, mapped_pointer value) noexcept
+            : key_{key}, value_{value}
+        {}
+
+        /// Iterator to const from iterator.
+        template <bool OtherConst>
+            requires(IsConst && !OtherConst)
+        IteratorBase(IteratorBase<OtherConst> const& other) noexcept
+            : key_{other.key_}, value_{other.value_}
+        {}
+
+        auto operator++() noexcept -> IteratorBase&
+        {
+            ++key_;
+            ++value_;
+            return *this;
+        }
+
+        auto operator++(int) noexcept -> IteratorBase
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        auto operator--() noexcept -> IteratorBase&
+        {
+            --key_;
+            --value_;
+            return *this;
+        }
+
+        auto operator--(int) noexcept -> IteratorBase
+        {
+            auto tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        auto operator+=(difference_type n) noexcept -> IteratorBase&
+        {
+            key_ += n;
+            value_ += n;
+            return *this;
+        }
+
+        auto operator-=(difference_type n) noexcept -> IteratorBase&
+        {
+            return *this += -n;
+        }
+
+        [[nodiscard]] friend auto operator+(IteratorBase it, difference_type n) noexcept
+            -> IteratorBase
+        {
+            return it += n;
+        }
+
+        [[nodiscard]] friend auto operator+(difference_type n, IteratorBase it) noexcept
+            -> IteratorBase
+        {
+            return it += n;
+        }
+
+        [[nodiscard]] friend auto operator-(IteratorBase it, difference_type n) noexcept
+            -> IteratorBase
+        {
+            return it -= n;
+        }
+
+        [[nodiscard]] auto operator-(IteratorBase const& other) const noexcept
+            -> difference_type
+        {
+            return key_ - other.key_;
+        }
+
+        auto operator*() const noexcept -> reference { return {*key_, *value_}; }
+
+        auto operator->() const noexcept -> Arrow { return Arrow{**this}; }
+
+        auto operator[](difference_type n) const noexcept -> reference
+        {
+            return *(*this + n);
+        }
+
+        auto operator==(IteratorBase const& other) const noexcept -> bool
+        {
+            return key_ == other.key_;
+        }
+
+        auto operator<=>(IteratorBase const& other) const noexcept
+        {
+            return key_ <=> other.key_;
+        }
+
+       private:
+        template <bool>
+        friend class IteratorBase;
+
+        K const* key_{nullptr};
+        mapped_pointer value_{nullptr};
+    };
+
+    using Iterator = IteratorBase<false>;
+    using ConstIterator = IteratorBase<true>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+   public:
+    FlatOrderedMap() = default;
+
+    /// Build from \p values in any order, sorted once; for equal keys the first wins.
+    explicit FlatOrderedMap(std::vector<value_type> values, Compare less = {})
+        : less_{std::move(less)}
+    {
+        auto const key_less = [this](value_type const& a, value_type const& b) {
+            return less_(a.first, b.first);
+        };
+        detail::sort_unique(values, key_less);
+
+        keys_.reserve(values.size());
+        values_.reserve(values.size());
+        for (auto& [key, value] : values) {
+            keys_.push_back(std::move(key));
+            values_.push_back(std::move(value));
+        }
+    }
+
+    FlatOrderedMap(std::initializer_list<value_type> values, Compare less = {})
+        : FlatOrderedMap{std::vector<value_type>(values), std::move(less)}
+    {}
+
+    template <std::input_iterator It>
+    FlatOrderedMap(It first, It last, Compare less = {})
+        : FlatOrderedMap{std::vector<value_type>(first, last), std::move(less)}
+    {}
+
+   public:
+    [[nodiscard]] auto begin() noexcept -> Iterator { return this->iterator_at(0); }
+    [[nodiscard]] auto begin() const noexcept -> ConstIterator
+    {
+        return this->iterator_at(0);
+    }
+
+    [[nodiscard]] auto end() noexcept -> Iterator
+    {
+        return this->iterator_at(keys_.size());
+    }
+    [[nodiscard]] auto end() const noexcept -> ConstIterator
+    {
+        return this->iterator_at(keys_.size());
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return keys_.size(); }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return keys_.empty(); }
+
+    /// Return the keys in order.
+    [[nodiscard]] auto keys() const noexcept -> std::span<K const> { return keys_; }
+
+    /// Return the values in the order of their keys.
+    [[nodiscard]] auto values() noexcept -> std::span<V> { return values_; }
+    [[nodiscard]] auto values() const noexcept -> std::span<V const> { return values_; }
+
+   public:
+    /// Return iterator to the element with \p key; otherwise end iter.
+    [[nodiscard]] auto find(K const& key) -> Iterator
+    {
+        return this->iterator_at(this->find_index(key));
+    }
+
+    [[nodiscard]] auto find(K const& key) const -> ConstIterator
+    {
+        return this->iterator_at(this->find_index(key));
+    }
+
+    template <typename Key>
+        requires(is_transparent && !std::same_as<Key, K>)
+    [[nodiscard]] auto find(Key const& key) -> Iterator
+    {
+        return this->iterator_at(this->find_index(key));
+    }
+
+    template <typename Key>
+        requires(is_transparent && !std::same_as<Key, K>)
+    [[nodiscard]] auto find(Key const& key) const -> ConstIterator
+    {
+        return this->iterator_at(this->find_index(key));
+    }
+
+    /// Return true if there is an element with \p key.
+    [[nodiscard]] auto contains(K const& key) const -> bool
+    {
+        return this->find_index(key) != keys_.size();
+    }
+
+    template <typename Key>
+        requires(is_transparent && !std::same_as<Key, K>)
+    [[nodiscard]] auto contains(Key const& key) const -> bool
+    {
+        return this->find_index(key) != keys_.size();
+    }
+
+    /// Return the value of the element with \p key, throws std::out_of_range if none.
+    [[nodiscard]] auto at(K const& key) -> V&
+    {
+        auto const at = this->find_index(key);
+        if (at == keys_.size())
+            throw std::out_of_range{"zzz::FlatOrderedMap::at(...) No such key."};
+        return values_[at];
+    }
+
+    [[nodiscard]] auto at(K const& key) const -> V const&
+    {
+        auto const at = this->find_index(key);
+        if (at == keys_.size())
+            throw std::out_of_range{"zzz::FlatOrderedMap::at(...) No such key."};
+        return values_[at];
+    }
+
+   public:
+    /// Insert an element with \p key and V constructed from \p args if there is none,
+    /// linear in the size of the map.
+    /** Return iterator to the element with \p key and true if it was inserted. */
+    template <typename... Args>
+    auto try_emplace(K key, Args&&... args) -> std::pair<Iterator, bool>
+    {
+        auto const at =
+            detail::branchless_lower_bound(keys_.data(), keys_.size(), key, less_);
+        if (at != keys_.size() && !less_(key, keys_[at])) {
+            return {this->iterator_at(at), false};
+        }
+        auto const offset = static_cast<std::ptrdiff_t>(at);
+        keys_.insert(keys_.begin() + offset, std::move(key));
+        try {
+            values_.emplace(values_.begin() + offset, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            keys_.erase(keys_.begin() + offset);
+            throw;
+        }
+        return {this->iterator_at(at), true};
+    }
+
+    /// Erase the element with \p key, return the number of elements erased.
+    auto erase(K const& key) -> std::size_t
+    {
+        auto const at = this->find_index(key);
+        if (at == keys_.size()) { return 0; }
+        keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(at));
+        values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(at));
+        return 1;
+    }
+
+   private:
+    [[nodiscard]] auto iterator_at(std::size_t at) noexcept -> Iterator
+    {
+        return {keys_.data() + at, values_.data() + at};
+    }
+
+    [[nodiscard]] auto iterator_at(std::size_t at) const noexcept -> ConstIterator
+    {
+        return {keys_.data() + at, values_.data() + at};
+    }
+
+    /// Return the index of \p key; otherwise keys_.size().
+    template <typename Key>
+    [[nodiscard]] auto find_index(Key const& key) const -> std::size_t
+    {
+        auto const at =
+            detail::branchless_lower_bound(keys_.data(), keys_.size(), key, less_);
+        return at != keys_.size() && !less_(key, keys_[at]) ? at : keys_.size();
+    }
+
+   private:
+    std::vector<K> keys_;
+    std::vector<V> values_;
+    [[no_unique_address]] Compare less_{};
+};
+
+}  // namespace zzz
@@ -1,10 +1,27 @@
 #pragma once
 
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <iterator>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#    include <format>
+#endif
+
+#include "./coro.hpp"
+#include "./simd.hpp"
 
 namespace zzz {
 
@@ -19,24 +36,299 @@ namespace zzz {
         return std::nullopt;
 }
 
+/**
+ * @brief Reads delimited lines from a stream into a reusable buffer.
+ * @details Lines are string_views into the buffer, no allocation is done per line.
+ * A line is only valid until the next line is read. Yields the same lines as repeated
+ * calls to zzz::getline.
+ */
+class LineReader {
+   public:
+    /// Read lines from \p is, the buffer grows beyond \p buffer_size for long lines.
+    explicit LineReader(std::istream& is,
+                        char delimiter = '\n',
+                        std::size_t buffer_size = 1 << 16)
+        : is_{&is},
+          delimiter_{delimiter},
+          buffer_(std::max<std::size_t>(buffer_size, 1))
+    {}
+
+   public:
+    /// Return the next line, not including the delimiter; nullopt at end of stream.
+    /** The returned view is invalidated by the next call. */
+    [[nodiscard]] auto next() -> std::optional<std::string_view>
+    {
+        while (true) {
+            auto const data = buffer_.data();
+            auto const at = detail::find_byte(data + scan_, data + end_, delimiter_);
+            if (at != data + end_) {
+                auto const line = std::string_view{
+                    data + begin_, static_cast<std::size_t>(at - (data + begin_))};
+                begin_ = scan_ = static_cast<std::size_t>(at - data) + 1;
+                return line;
+            }
+            scan_ = end_;
+
+            if (eof_) {
+                if (begin_ == end_) { return std::nullopt; }
+                auto const line = std::string_view{data + begin_, end_ - begin_};
+                begin_ = end_;
+                return line;
+            }
+            this->refill();
+        }
+    }
+
+    /// Return a Generator over the remaining lines, for use in range-for.
+    /** Each line is only valid until the Generator is advanced. */
+    [[nodiscard]] auto lines() -> Generator<std::string_view>
+    {
+        while (auto line = this->next()) {
+            co_yield *line;
+        }
+    }
+
+   private:
+    /// Keep the partial line at the front of the buffer and read after it.
+    void refill()
+    {
+        if (begin_ != 0) {
+            std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+            end_ -= begin_;
+            scan_ -= begin_;
+            begin_ = 0;
+        }
+        if (end_ == buffer_.size()) { buffer_.resize(buffer_.size() * 2); }
+
+        is_->read(buffer_.data() + end_,
+                  static_cast<std::streamsize>(buffer_.size() - end_));
+        end_ += static_cast<std::size_t>(is_->gcount());
+        eof_ = !*is_;
+    }
+
+   private:
+    std::istream* is_;
+    char delimiter_;
+    std::vector<char> buffer_;
+    std::size_t begin_{0};  // Start of the next line.
+    std::size_t scan_{0};   // Bytes before this are known not to be delimiters.
+    std::size_t end_{0};    // End of the bytes read so far.
+    bool eof_{false};
+};
+
+namespace detail {
+
+/// Return true if \p os formats numbers as it does when newly constructed.
+[[nodiscard]] inline auto has_default_format(std::ios_base const& os) -> bool
+{
+    return os.flags() == (std::ios_base::dec | std::ios_base::skipws) &&
+           os.precision() == 6;
+}
+
+/// Return true if what \p os writes doesn't depend on its locale or padding, so
+/// that formatting into a buffer with the same flags gives the same output.
+[[nodiscard]] inline auto is_bufferable(std::ostream const& os) -> bool
+{
+    return os.width() == 0 && os.fill() == ' ' &&
+           os.getloc() == std::locale::classic();
+}
+
+/// Types operator<< prints as a single character.
+template <typename T>
+concept Character = std::same_as<T, char> || std::same_as<T, signed char> ||
+                    std::same_as<T, unsigned char>;
+
+/**
+ * A T reused across calls on the same thread, to keep its allocation.
+ * @details Only the outermost of nested calls gets the reused T, e.g. when an element
+ * printed by print has an operator<< that calls print itself; the nested calls get
+ * a new T each.
+ */
+template <typename T>
+class ReusedBuffer {
+   public:
+    ReusedBuffer() : owner_{!in_use()}
+    {
+        if (owner_) {
+            in_use() = true;
+        }
+        else {
+            nested_.emplace();
+        }
+    }
+
+    ReusedBuffer(ReusedBuffer const&) = delete;
+    auto operator=(ReusedBuffer const&) -> ReusedBuffer& = delete;
+
+    ~ReusedBuffer()
+    {
+        if (owner_) { in_use() = false; }
+    }
+
+    [[nodiscard]] auto get() -> T& { return owner_ ? shared() : *nested_; }
+
+   private:
+    [[nodiscard]] static auto shared() -> T&
+    {
+        thread_local auto x = T{};
+        return x;
+    }
+
+    [[nodiscard]] static auto in_use() -> bool&
+    {
+        thread_local auto x = false;
+        return x;
+    }
+
+   private:
+    bool owner_;
+    std::optional<T> nested_;
+};
+
+/// Append \p x to \p out as operator<< would, with the given stream format and the
+/// classic locale.
+template <typename T>
+void append_streamed(std::string& out,
+                     T const& x,
+                     std::ios_base::fmtflags flags = std::ios_base::dec |
+                                                     std::ios_base::skipws,
+                     std::streamsize precision = 6)
+{
+    auto stream = ReusedBuffer<std::ostringstream>{};
+    auto& ss = stream.get();
+    ss.str({});
+    ss.clear();
+    if (ss.getloc() != std::locale::classic()) { ss.imbue(std::locale::classic()); }
+    ss.flags(flags);
+    ss.precision(precision);
+    ss << x;
+    out += ss.view();
+}
+
+/// Append \p x to \p out as operator<< would on a stream with the default format
+/// and the classic locale.
+template <typename T>
+void append_element(std::string& out, T const& x)
+{
+    if constexpr (Character<T>) {
+        out.push_back(static_cast<char>(x));
+    }
+    else if constexpr (std::same_as<T, bool>) {
+        out.push_back(x ? '1' : '0');
+    }
+    else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+        char buffer[64];
+        auto const [end, error] = [&] {
+            if constexpr (std::is_floating_point_v<T>) {
+                // Same as %g with precision 6, the stream default.
+                return std::to_chars(buffer, buffer + sizeof(buffer), x,
+                                     std::chars_format::general, 6);
+            }
+            else {
+                return std::to_chars(buffer, buffer + sizeof(buffer), x);
+            }
+        }();
+        out.append(buffer, end);
+    }
+    else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+        out += std::string_view{x};
+    }
+    else {
+        append_streamed(out, x);
+    }
+}
+
+}  // namespace detail
+
+/// Append each element of an iterable \p x to \p out, surrounded by {} and ,
+/// delimiters.
+/** Elements are formatted as operator<< would on a default constructed stream with
+ *  the classic locale. */
+template <typename Iterable>
+auto print(std::string& out, Iterable const& x) -> std::string&
+{
+    out += "{ ";
+    auto first = true;
+    for (auto const& element : x) {
+        if (!first) { out += ", "; }
+        first = false;
+        detail::append_element(out, element);
+    }
+    out += " }";
+    return out;
+}
+
 /// Print out each element of an iterable \p x to \p os, surrounded by {} and ,
 /// delimiters.
+/** Unless \p os pads or has a locale other than the classic one, the output is built
+ *  in a reused buffer and written to \p os at once. Otherwise each part is written
+ *  with operator<<, so the width applies to the opening brace. */
 template <typename Iterable>
 auto print(std::ostream& os, Iterable const& x) -> std::ostream&
 {
-    using std::begin;
-    using std::end;
+    if (!detail::is_bufferable(os)) {
+        os << "{ ";
+        auto first = true;
+        for (auto const& element : x) {
+            if (!first) { os << ", "; }
+            first = false;
+            os << element;
+        }
+        return os << " }";
+    }
+
+    auto reused = detail::ReusedBuffer<std::string>{};
+    auto& buffer = reused.get();
+    buffer.clear();
+    if (detail::has_default_format(os)) {
+        print(buffer, x);
+    }
+    else {
+        buffer += "{ ";
+        auto first = true;
+        for (auto const& element : x) {
+            if (!first) { buffer += ", "; }
+            first = false;
+            detail::append_streamed(buffer, element, os.flags(), os.precision());
+        }
+        buffer += " }";
+    }
+    return os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
 
-    os << "{ ";
-    auto it = begin(x);
-    auto it_end = end(x);
+#if defined(__cpp_lib_format)
 
-    for (; it != it_end; ++it) {
-        os << *it;
-        if (std::next(it) != it_end) { os << ", "; }
+/// Append each element of an iterable \p x to \p out, surrounded by {} and ,
+/// delimiters, each element formatted with the std::format string \p element_format.
+template <typename Iterable>
+auto print(std::string& out, Iterable const& x, std::string_view element_format)
+    -> std::string&
+{
+    out += "{ ";
+    auto first = true;
+    for (auto const& element : x) {
+        if (!first) { out += ", "; }
+        first = false;
+        std::vformat_to(std::back_inserter(out), element_format,
+                        std::make_format_args(element));
     }
-    os << " }";
-    return os;
+    out += " }";
+    return out;
 }
 
+/// Print out each element of an iterable \p x to \p os, surrounded by {} and ,
+/// delimiters, each element formatted with the std::format string \p element_format.
+template <typename Iterable>
+auto print(std::ostream& os, Iterable const& x, std::string_view element_format)
+    -> std::ostream&
+{
+    auto reused = detail::ReusedBuffer<std::string>{};
+    auto& buffer = reused.get();
+    buffer.clear();
+    print(buffer, x, element_format);
+    return os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+#endif  // __cpp_lib_format
+
 }  // namespace zzz
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "./string.hpp"
+
+namespace zzz {
+
+/**
+ * A read-only memory mapping of a whole file, POSIX only.
+ * @details The contents are exposed as a string_view, so the string helpers can
+ * parse a file without copying it. The mapping is released on destruction.
+ */
+class MappedFile {
+   public:
+    /// How the mapping is expected to be read, passed on to the kernel as a hint.
+    enum class Access { Sequential, Random };
+
+   public:
+    /// Create an empty MappedFile that maps nothing.
+    MappedFile() = default;
+
+    /**
+     * Map the file at \p path.
+     * @details Throws std::system_error if the file can't be opened or mapped.
+     * @param path The file to map
+     * @param access Sequential also asks the kernel to read ahead the whole file
+     */
+    explicit MappedFile(std::filesystem::path const& path,
+                        Access access = Access::Sequential)
+    {
+        auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1) { throw_errno("zzz::MappedFile(...) Can't open file."); }
+
+        struct stat info {};
+        if (::fstat(fd, &info) == -1) {
+            auto const error = errno;
+            ::close(fd);
+            throw_errno("zzz::MappedFile(...) Can't stat file.", error);
+        }
+
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ != 0) {
+            auto const data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                auto const error = errno;
+                ::close(fd);
+                throw_errno("zzz::MappedFile(...) Can't map file.", error);
+            }
+            data_ = static_cast<char const*>(data);
+
+            // Hints only, failure is not an error.
+            if (access == Access::Sequential) {
+                ::madvise(data, size_, MADV_SEQUENTIAL);
+                ::madvise(data, size_, MADV_WILLNEED);
+            }
+            else {
+                ::madvise(data, size_, MADV_RANDOM);
+            }
+        }
+        ::close(fd);  // The mapping keeps its own reference to the file.
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    auto operator=(MappedFile const&) -> MappedFile& = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)}
+    {}
+
+    auto operator=(MappedFile&& other) noexcept -> MappedFile&
+    {
+        if (this != &other) {
+            this->unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { this->unmap(); }
+
+   public:
+    /// Return the contents of the file.
+    [[nodiscard]] auto view() const noexcept -> std::string_view
+    {
+        return {data_, size_};
+    }
+
+    /// Return the size of the file in bytes.
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+
+    /// Return a lazy view over each line, not including the newline.
+    [[nodiscard]] auto lines() const -> SplitView
+    {
+        return split_view(this->view(), "\n");
+    }
+
+    /// Return a lazy view over the segments of the file split on \p delimiter.
+    /** The view copies \p delimiter, so it may be a temporary; the file must outlive
+     *  the view. */
+    [[nodiscard]] auto split(std::string_view delimiter) const -> SplitView
+    {
+        return split_view(this->view(), delimiter);
+    }
+
+   private:
+    void unmap() noexcept
+    {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    [[noreturn]] static void throw_errno(char const* what, int error = errno)
+    {
+        throw std::system_error{error, std::generic_category(), what};
+    }
+
+   private:
+    char const* data_{nullptr};
+    std::size_t size_{0};
+};
+
+}  // namespace zzz
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./container.hpp"
+#include "./simd.hpp"
+#include "./string.hpp"
+#include "./thread_pool.hpp"
+
+namespace zzz {
+
+/// Return the number of threads to use when none is given, at least one.
+[[nodiscard]] inline auto default_thread_count() -> std::size_t
+{
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+/// Split \p x into at most \p count chunks of similar size, each ending just after a
+/// \p delimiter, except for the last chunk. No line is split across chunks.
+[[nodiscard]] inline auto chunk_lines(std::string_view x,
+                                      std::size_t count,
+                                      char delimiter = '\n')
+    -> std::vector<std::string_view>
+{
+    auto result = std::vector<std::string_view>{};
+    count = std::max<std::size_t>(count, 1);
+    result.reserve(count);
+
+    auto const last = x.data() + x.size();
+    auto begin = x.data();
+    for (auto i = std::size_t{1}; i <= count && begin != last; ++i) {
+        auto end = last;
+        if (i != count) {
+            auto const target = std::max(begin, x.data() + x.size() * i / count);
+            end = detail::find_byte(target, last, delimiter);
+            end = (end == last) ? last : end + 1;
+        }
+        result.emplace_back(begin, static_cast<std::size_t>(end - begin));
+        begin = end;
+    }
+    return result;
+}
+
+namespace detail {
+
+/// The pool the parallel algorithms run on, one worker per hardware thread, started
+/// on first use.
+[[nodiscard]] inline auto shared_thread_pool() -> ThreadPool&
+{
+    static auto pool = ThreadPool{};
+    return pool;
+}
+
+/// Run \p fn(i) for each i in [0, count) on the shared pool and the calling thread,
+/// and wait for all.
+/** The first exception thrown by \p fn is rethrown, see ThreadPool::parallel_for. */
+template <typename F>
+void run_chunks(std::size_t count, F const& fn)
+{
+    if (count == 1) {
+        fn(std::size_t{0});
+        return;
+    }
+    shared_thread_pool().parallel_for(0, count, fn, 1);
+}
+
+}  // namespace detail
+
+/// Call \p fn with each line of \p x, not including the delimiter.
+/** Lines are split into \p chunk_count chunks, processed on the shared pool, which
+ *  has one worker per hardware thread, so \p fn must be safe to call concurrently.
+ *  Lines are the same as split_view(x, "\n") produces. */
+template <typename F>
+void for_each_line(std::string_view x,
+                   F const& fn,
+                   std::size_t chunk_count = default_thread_count(),
+                   char delimiter = '\n')
+{
+    auto const chunks = chunk_lines(x, chunk_count, delimiter);
+    auto const separator = std::string_view{&delimiter, 1};
+    detail::run_chunks(chunks.size(), [&](std::size_t i) {
+        for (auto line : split_view(chunks[i], separator)) {
+            fn(line);
+        }
+    });
+}
+
+/// Fold each line of \p x with F(U, std::string_view), starting from \p initial.
+/** \p x is split into \p chunk_count chunks of lines, each folded with zzz::reduce
+ *  on the shared pool starting from \p initial, then the partial results are combined
+ *  in order with M(U, U). \p initial must be an identity of \p merge, and \p merge
+ *  must be associative. */
+template <typename F, typename M, typename U>
+[[nodiscard]] auto reduce_lines(F const& func,
+                                M const& merge,
+                                U initial,
+                                std::string_view x,
+                                std::size_t chunk_count = default_thread_count(),
+                                char delimiter = '\n') -> U
+{
+    auto const chunks = chunk_lines(x, chunk_count, delimiter);
+    auto const separator = std::string_view{&delimiter, 1};
+
+    // Wrapped so that each thread writes to its own object, even for bool.
+    struct Partial {
+        U value;
+    };
+    auto partials = std::vector<Partial>(chunks.size(), Partial{initial});
+    detail::run_chunks(chunks.size(), [&](std::size_t i) {
+        partials[i].value = zzz::reduce(func, std::move(partials[i].value),
+                                        split_view(chunks[i], separator));
+    });
+
+    auto result = std::move(initial);
+    for (auto& partial : partials) {
+        result = merge(std::move(result), std::move(partial.value));
+    }
+    return result;
+}
+
+namespace detail {
+
+/// Fold the non-empty range [first, last) with F(U, T), returning U.
+/** Uses four independent accumulators to break the dependency chain, so \p func is
+ *  assumed to be associative and commutative. */
+template <typename U, typename F, std::random_access_iterator Iter>
+[[nodiscard]] auto reduce_chunk(F const& func, Iter first, Iter last) -> U
+{
+    auto const size = last - first;
+    if (size < 8) {
+        auto result = U(*first);
+        for (++first; first != last; ++first) {
+            result = func(std::move(result), *first);
+        }
+        return result;
+    }
+
+    auto a = U(first[0]);
+    auto b = U(first[1]);
+    auto c = U(first[2]);
+    auto d = U(first[3]);
+    auto i = decltype(size){4};
+    for (; size - i >= 4; i += 4) {
+        a = func(std::move(a), first[i]);
+        b = func(std::move(b), first[i + 1]);
+        c = func(std::move(c), first[i + 2]);
+        d = func(std::move(d), first[i + 3]);
+    }
+    for (; i < size; ++i) {
+        a = func(std::move(a), first[i]);
+    }
+    return func(func(std::move(a), std::move(b)), func(std::move(c), std::move(d)));
+}
+
+/// Fold \p x with \p func in up to \p chunk_count chunks, see zzz::reduce.
+template <typename F, typename U, std::ranges::random_access_range R>
+[[nodiscard]] auto parallel_reduce(F const& func,
+                                   U initial,
+                                   R const& x,
+                                   std::size_t chunk_count) -> U
+{
+    // Below this many elements per chunk, handing it to a worker costs more than it
+    // saves.
+    constexpr auto min_chunk_size = std::size_t{1} << 14;
+
+    auto const size = static_cast<std::size_t>(std::ranges::distance(x));
+    if (size == 0) { return initial; }
+    auto const max_chunks = std::max(size / min_chunk_size, std::size_t{1});
+    chunk_count = std::clamp<std::size_t>(chunk_count, 1, max_chunks);
+
+    auto const first = std::ranges::begin(x);
+    auto partials = std::vector<std::optional<U>>(chunk_count);
+    run_chunks(chunk_count, [&](std::size_t i) {
+        auto const begin = static_cast<std::ptrdiff_t>(size * i / chunk_count);
+        auto const end = static_cast<std::ptrdiff_t>(size * (i + 1) / chunk_count);
+        partials[i].emplace(reduce_chunk<U>(func, first + begin, first + end));
+    });
+
+    // Combine neighbours pairwise, in a tree of depth log2(chunk_count).
+    for (auto stride = std::size_t{1}; stride < chunk_count; stride *= 2) {
+        for (auto i = std::size_t{0}; i + stride < chunk_count; i += 2 * stride) {
+            *partials[i] =
+                func(std::move(*partials[i]), std::move(*partials[i + stride]));
+        }
+    }
+    return func(std::move(initial), std::move(*partials[0]));
+}
+
+}  // namespace detail
+
+/// Apply result of F(U, T) to each element in \p x, split in \p chunk_count chunks.
+/** Same semantics as std::reduce: the chunks run on the shared pool, which has one
+ *  worker per hardware thread, and the partial results are combined in a tree, so
+ *  \p func must be associative and commutative, and also accept (U, U). */
+template <typename F, typename U, std::ranges::random_access_range R>
+[[nodiscard]] auto reduce(F&& func, U initial, R const& x, std::size_t chunk_count)
+    -> U
+{
+    return detail::parallel_reduce(func, std::move(initial), x, chunk_count);
+}
+
+}  // namespace zzz
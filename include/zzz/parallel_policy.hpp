@@ -0,0 +1,34 @@
+#pragma once
+
+#include <execution>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "./parallel.hpp"
+
+namespace zzz {
+
+/// Apply result of F(U, T) to each element in \p x, with an execution policy.
+/**
+ * Same semantics as std::reduce. Parallel policies use every core, sequenced ones
+ * run on the calling thread, always with the reordering std::reduce permits.
+ *
+ * This overload is in its own header as it needs <execution>, which libstdc++
+ * implements on top of TBB whenever the TBB headers are installed: link TBB, or
+ * define _GLIBCXX_USE_TBB_PAR_BACKEND=0 for its serial backend. Only the policy
+ * types are used, no standard parallel algorithm is called.
+ */
+template <typename Policy, typename F, typename U, std::ranges::random_access_range R>
+    requires std::is_execution_policy_v<std::remove_cvref_t<Policy>>
+[[nodiscard]] auto reduce(Policy&&, F&& func, U initial, R const& x) -> U
+{
+    using P = std::remove_cvref_t<Policy>;
+    constexpr auto is_parallel =
+        std::is_same_v<P, std::execution::parallel_policy> ||
+        std::is_same_v<P, std::execution::parallel_unsequenced_policy>;
+    return detail::parallel_reduce(func, std::move(initial), x,
+                                   is_parallel ? default_thread_count() : 1);
+}
+
+}  // namespace zzz
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+
+#include "./task.hpp"
+#include "./work_stealing_executor.hpp"
+
+namespace zzz {
+
+/**
+ * @brief Thread pool that resumes coroutines, `co_await scheduler.schedule()` moves
+ * the awaiting coroutine onto one of its worker threads.
+ * @details The workers are a detail::WorkStealingExecutor: a coroutine scheduled
+ * from a worker stays on that worker unless an idle one steals it, and idle workers
+ * sleep until new work is scheduled.
+ *
+ * The destructor waits for the workers to run every scheduled coroutine, including
+ * those scheduled meanwhile, and then joins them.
+ */
+class Scheduler {
+   public:
+    /// Awaitable that resumes the awaiting coroutine on a worker.
+    struct ScheduleAwaiter {
+        auto await_ready() const noexcept -> bool { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) { scheduler.post(handle); }
+
+        void await_resume() const noexcept {}
+
+        Scheduler& scheduler;
+    };
+
+   public:
+    /// Start \p thread_count workers, at least one; one per hardware thread if zero.
+    explicit Scheduler(std::size_t thread_count = 0) : executor_{thread_count} {}
+
+    Scheduler(Scheduler const&) = delete;
+    auto operator=(Scheduler const&) -> Scheduler& = delete;
+
+   public:
+    /// Return an awaitable that resumes the awaiting coroutine on a worker.
+    [[nodiscard]] auto schedule() noexcept -> ScheduleAwaiter { return {*this}; }
+
+    /// Resume \p handle on a worker.
+    void post(std::coroutine_handle<> handle) { executor_.push(handle); }
+
+    /// Return the number of worker threads.
+    [[nodiscard]] auto thread_count() const noexcept -> std::size_t
+    {
+        return executor_.thread_count();
+    }
+
+   private:
+    struct Resume {
+        void operator()(std::coroutine_handle<> handle) const noexcept
+        {
+            handle.resume();
+        }
+    };
+
+   private:
+    detail::WorkStealingExecutor<std::coroutine_handle<>, Resume> executor_;
+};
+
+}  // namespace zzz
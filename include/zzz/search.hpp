@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+#include "./simd.hpp"
+
+namespace zzz {
+
+/**
+ * @brief Precompiled substring matcher, reusable across many searches.
+ * @details The algorithm is picked by needle length. Short needles use a vectorized
+ * first/last byte filter, long needles use the Two-Way algorithm with a bad character
+ * shift table, which is linear in the worst case. The needle is not copied, it must
+ * outlive the Searcher.
+ */
+class Searcher {
+   public:
+    /// Needles up to this size use the vectorized filter.
+    static constexpr std::size_t max_short_size = 32;
+
+   public:
+    /// Create a Searcher for \p needle, an empty needle matches at the beginning.
+    explicit Searcher(std::string_view needle) : needle_{needle}
+    {
+        if (needle_.size() > max_short_size) { this->compile(); }
+    }
+
+   public:
+    /// Return iterator to first occurance of the needle in \p x; otherwise end iter.
+    [[nodiscard]] auto operator()(std::string_view x) const
+        -> std::string_view::const_iterator
+    {
+        auto const first = x.data();
+        auto const last = first + x.size();
+        auto const at = needle_.size() > max_short_size
+                            ? this->two_way(first, last)
+                            : detail::find_segment(first, last, needle_);
+        return std::next(std::cbegin(x), at - first);
+    }
+
+    /// Return the needle this Searcher was created with.
+    [[nodiscard]] auto needle() const -> std::string_view { return needle_; }
+
+   private:
+    /// Critical factorization of the needle and the bad character shift table.
+    void compile()
+    {
+        auto const n = reinterpret_cast<unsigned char const*>(needle_.data());
+        auto const length = needle_.size();
+
+        // Distance from the last occurance of each byte to the end of the needle,
+        // clamped to fit a byte; a shorter shift is always safe.
+        shift_.fill(static_cast<std::uint8_t>(std::min<std::size_t>(length, 255)));
+        for (auto i = std::size_t{0}; i < length; ++i) {
+            shift_[n[i]] =
+                static_cast<std::uint8_t>(std::min<std::size_t>(length - 1 - i, 255));
+        }
+
+        // Maximal suffix for both orderings, the later one is the critical position.
+        auto const maximal_suffix = [&](bool reversed) {
+            auto ip = static_cast<std::size_t>(-1);
+            auto jp = std::size_t{0};
+            auto k = std::size_t{1};
+            auto p = std::size_t{1};
+            while (jp + k < length) {
+                auto const a = n[ip + k];
+                auto const b = n[jp + k];
+                if (a == b) {
+                    if (k == p) {
+                        jp += p;
+                        k = 1;
+                    }
+                    else {
+                        ++k;
+                    }
+                }
+                else if (reversed ? a < b : a > b) {
+                    jp += k;
+                    k = 1;
+                    p = jp - ip;
+                }
+                else {
+                    ip = jp++;
+                    k = p = 1;
+                }
+            }
+            return std::array<std::size_t, 2>{ip, p};
+        };
+
+        auto const [ms0, p0] = maximal_suffix(false);
+        auto const [ms1, p1] = maximal_suffix(true);
+        split_ = (ms1 + 1 > ms0 + 1) ? ms1 : ms0;
+        period_ = (ms1 + 1 > ms0 + 1) ? p1 : p0;
+
+        // Periodic needles remember how much of the previous attempt matched.
+        if (std::memcmp(n, n + period_, split_ + 1) != 0) {
+            memory_ = 0;
+            period_ = std::max(split_, length - split_ - 1) + 1;
+        }
+        else {
+            memory_ = length - period_;
+        }
+    }
+
+    /// Return pointer to first needle in [first, last); otherwise \p last.
+    [[nodiscard]] auto two_way(char const* first, char const* last) const
+        -> char const*
+    {
+        auto const n = reinterpret_cast<unsigned char const*>(needle_.data());
+        auto const h = reinterpret_cast<unsigned char const*>(first);
+        auto const length = needle_.size();
+        auto const size = static_cast<std::size_t>(last - first);
+
+        auto at = std::size_t{0};
+        auto memory = std::size_t{0};
+        while (size - at >= length) {
+            // Check the last byte first and skip ahead on mismatch.
+            if (auto const shift = std::size_t{shift_[h[at + length - 1]]};
+                shift != 0) {
+                at += std::max(shift, memory);
+                memory = 0;
+                continue;
+            }
+
+            // Compare right half.
+            auto k = std::max(split_ + 1, memory);
+            while (k < length && n[k] == h[at + k]) {
+                ++k;
+            }
+            if (k < length) {
+                at += k - split_;
+                memory = 0;
+                continue;
+            }
+
+            // Compare left half.
+            k = split_ + 1;
+            while (k > memory && n[k - 1] == h[at + k - 1]) {
+                --k;
+            }
+            if (k <= memory) { return first + at; }
+            at += period_;
+            memory = memory_;
+        }
+        return last;
+    }
+
+   private:
+    std::string_view needle_;
+    std::size_t split_{0};
+    std::size_t period_{0};
+    std::size_t memory_{0};
+    std::array<std::uint8_t, 256> shift_{};
+};
+
+}  // namespace zzz
@@ -0,0 +1,722 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#    define ZZZ_SIMD_X86 1
+#    include <immintrin.h>
+#endif
+
+/**
+ * @brief Vectorized kernels behind the string and container helpers.
+ * @details Each kernel has a portable scalar version and, on x86 with GCC or Clang,
+ * SSE2 and AVX2 versions. The widest version supported by the running CPU is
+ * selected at runtime, unless the translation unit is already compiled for AVX2.
+ */
+
+namespace zzz::detail {
+
+/// Instruction sets a kernel can be dispatched to, in order of preference.
+enum class Isa { Scalar, SSE2, AVX2 };
+
+/// Return the widest instruction set supported by the running CPU.
+[[nodiscard]] inline auto detected_isa() noexcept -> Isa
+{
+#if defined(ZZZ_SIMD_X86)
+#    if defined(__AVX2__)
+    return Isa::AVX2;
+#    else
+    static auto const isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) { return Isa::AVX2; }
+        if (__builtin_cpu_supports("sse2")) { return Isa::SSE2; }
+        return Isa::Scalar;
+    }();
+    return isa;
+#    endif
+#else
+    return Isa::Scalar;
+#endif
+}
+
+/// Return true if kernels for \p isa can run on this CPU.
+[[nodiscard]] inline auto is_supported(Isa isa) noexcept -> bool
+{
+    return isa <= detected_isa();
+}
+
+/// Hint that \p address will be read soon, so the cache line can be loaded early.
+inline void prefetch(void const* address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+// find_byte -----------------------------------------------------------------------
+
+/// Return pointer to first \p c in [first, last); otherwise \p last.
+[[nodiscard]] inline auto find_byte_scalar(char const* first, char const* last, char c)
+    -> char const*
+{
+    return std::find(first, last, c);
+}
+
+#if defined(ZZZ_SIMD_X86)
+
+/// Bitmask of the bytes equal to \p needle in the 16 bytes at \p at.
+[[nodiscard]] __attribute__((target("sse2"))) inline auto match_16(char const* at,
+                                                                  __m128i needle)
+    -> unsigned
+{
+    auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(at));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+}
+
+/// Bitmask of the bytes equal to \p needle in the 32 bytes at \p at.
+[[nodiscard]] __attribute__((target("avx2"))) inline auto match_32(char const* at,
+                                                                  __m256i needle)
+    -> unsigned
+{
+    auto const block = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(at));
+    auto const equal = _mm256_cmpeq_epi8(block, needle);
+    return static_cast<unsigned>(_mm256_movemask_epi8(equal));
+}
+
+[[nodiscard]] __attribute__((target("sse2"))) inline auto find_byte_sse2(
+    char const* first,
+    char const* last,
+    char c) -> char const*
+{
+    if (last - first < 16) { return find_byte_scalar(first, last, c); }
+
+    auto const needle = _mm_set1_epi8(c);
+    auto at = first;
+    for (; last - at >= 16; at += 16) {
+        if (auto const mask = match_16(at, needle); mask != 0) {
+            return at + __builtin_ctz(mask);
+        }
+    }
+    if (at == last) { return last; }
+
+    // Overlapping final block, the bytes before `at` are known not to match.
+    at = last - 16;
+    if (auto const mask = match_16(at, needle); mask != 0) {
+        return at + __builtin_ctz(mask);
+    }
+    return last;
+}
+
+[[nodiscard]] __attribute__((target("avx2"))) inline auto find_byte_avx2(
+    char const* first,
+    char const* last,
+    char c) -> char const*
+{
+    if (last - first < 32) { return find_byte_sse2(first, last, c); }
+
+    auto const needle = _mm256_set1_epi8(c);
+    auto at = first;
+    for (; last - at >= 32; at += 32) {
+        if (auto const mask = match_32(at, needle); mask != 0) {
+            return at + __builtin_ctz(mask);
+        }
+    }
+    if (at == last) { return last; }
+
+    // Overlapping final block, the bytes before `at` are known not to match.
+    at = last - 32;
+    if (auto const mask = match_32(at, needle); mask != 0) {
+        return at + __builtin_ctz(mask);
+    }
+    return last;
+}
+
+#endif  // ZZZ_SIMD_X86
+
+/// Return pointer to first \p c in [first, last); otherwise \p last.
+[[nodiscard]] inline auto find_byte(char const* first, char const* last, char c)
+    -> char const*
+{
+#if defined(ZZZ_SIMD_X86)
+    if (last - first < 16) { return find_byte_scalar(first, last, c); }
+#    if defined(__SSE2__)
+    // Matches close to the start are common when tokenizing, the first blocks are
+    // checked inline where the call to a dispatched kernel would dominate.
+    auto const needle = _mm_set1_epi8(c);
+    for (auto const prelude = first + 64; first < prelude && last - first >= 16;
+         first += 16) {
+        if (auto const mask = match_16(first, needle); mask != 0) {
+            return first + __builtin_ctz(mask);
+        }
+    }
+    if (last - first < 64) { return find_byte_sse2(first, last, c); }
+#    endif
+    switch (detected_isa()) {
+        case Isa::AVX2: return find_byte_avx2(first, last, c);
+        case Isa::SSE2: return find_byte_sse2(first, last, c);
+        case Isa::Scalar: break;
+    }
+#endif
+    return find_byte_scalar(first, last, c);
+}
+
+// find_segment --------------------------------------------------------------------
+
+/// Return pointer to first \p segment in [first, last); otherwise \p last.
+[[nodiscard]] inline auto find_segment_scalar(char const* first,
+                                              char const* last,
+                                              std::string_view segment) -> char const*
+{
+    return std::search(first, last, std::cbegin(segment), std::cend(segment));
+}
+
+#if defined(ZZZ_SIMD_X86)
+
+/// Filters candidate positions on the first and last byte of \p segment, and only
+/// compares the bytes in between for positions where both match.
+/** \p segment must be at least two bytes long. */
+[[nodiscard]] __attribute__((target("sse2"))) inline auto find_segment_sse2(
+    char const* first,
+    char const* last,
+    std::string_view segment) -> char const*
+{
+    auto const tail = segment.size() - 1;
+    auto const front = _mm_set1_epi8(segment.front());
+    auto const back = _mm_set1_epi8(segment.back());
+
+    auto at = first;
+    for (; static_cast<std::size_t>(last - at) >= tail + 16; at += 16) {
+        auto mask = match_16(at, front) & match_16(at + tail, back);
+        while (mask != 0) {
+            auto const candidate = at + __builtin_ctz(mask);
+            if (std::memcmp(candidate + 1, segment.data() + 1, tail - 1) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return find_segment_scalar(at, last, segment);
+}
+
+/// Filters candidate positions on the first and last byte of \p segment, and only
+/// compares the bytes in between for positions where both match.
+/** \p segment must be at least two bytes long. */
+[[nodiscard]] __attribute__((target("avx2"))) inline auto find_segment_avx2(
+    char const* first,
+    char const* last,
+    std::string_view segment) -> char const*
+{
+    auto const tail = segment.size() - 1;
+    auto const front = _mm256_set1_epi8(segment.front());
+    auto const back = _mm256_set1_epi8(segment.back());
+
+    auto at = first;
+    for (; static_cast<std::size_t>(last - at) >= tail + 32; at += 32) {
+        auto mask = match_32(at, front) & match_32(at + tail, back);
+        while (mask != 0) {
+            auto const candidate = at + __builtin_ctz(mask);
+            if (std::memcmp(candidate + 1, segment.data() + 1, tail - 1) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return find_segment_sse2(at, last, segment);
+}
+
+#endif  // ZZZ_SIMD_X86
+
+/// Return pointer to first \p segment in [first, last); otherwise \p last.
+/** Verification is not bounded for long segments, see zzz::Searcher for those. */
+[[nodiscard]] inline auto find_segment(char const* first,
+                                       char const* last,
+                                       std::string_view segment) -> char const*
+{
+    if (segment.size() < 2) {
+        return segment.empty() ? first : find_byte(first, last, segment.front());
+    }
+#if defined(ZZZ_SIMD_X86)
+    switch (detected_isa()) {
+        case Isa::AVX2: return find_segment_avx2(first, last, segment);
+        case Isa::SSE2: return find_segment_sse2(first, last, segment);
+        case Isa::Scalar: break;
+    }
+#endif
+    return find_segment_scalar(first, last, segment);
+}
+
+// ascii_flip_case -----------------------------------------------------------------
+
+/// Copy [first, first + size) to \p out, flipping the case of bytes in [lo, hi].
+/** \p lo and \p hi bound an ASCII letter range, \p out may alias \p first. */
+inline void ascii_flip_case_scalar(char const* first,
+                                   std::size_t size,
+                                   char* out,
+                                   char lo,
+                                   char hi) noexcept
+{
+    auto const span = static_cast<unsigned char>(hi - lo);
+    for (auto i = std::size_t{0}; i < size; ++i) {
+        auto const c = static_cast<unsigned char>(first[i]);
+        auto const in_range = static_cast<unsigned char>(c - lo) <= span;
+        out[i] = static_cast<char>(c ^ (in_range << 5));
+    }
+}
+
+#if defined(ZZZ_SIMD_X86)
+
+__attribute__((target("sse2"))) inline void ascii_flip_case_sse2(char const* first,
+                                                                 std::size_t size,
+                                                                 char* out,
+                                                                 char lo,
+                                                                 char hi) noexcept
+{
+    // Signed compares, bytes above 0x7f are negative and never in range.
+    auto const below = _mm_set1_epi8(static_cast<char>(lo - 1));
+    auto const above = _mm_set1_epi8(static_cast<char>(hi + 1));
+    auto const flip = _mm_set1_epi8(0x20);
+
+    auto i = std::size_t{0};
+    for (; size - i >= 16; i += 16) {
+        auto const c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first + i));
+        auto const in_range =
+            _mm_and_si128(_mm_cmpgt_epi8(c, below), _mm_cmplt_epi8(c, above));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_xor_si128(c, _mm_and_si128(in_range, flip)));
+    }
+    ascii_flip_case_scalar(first + i, size - i, out + i, lo, hi);
+}
+
+__attribute__((target("avx2"))) inline void ascii_flip_case_avx2(char const* first,
+                                                                 std::size_t size,
+                                                                 char* out,
+                                                                 char lo,
+                                                                 char hi) noexcept
+{
+    // Signed compares, bytes above 0x7f are negative and never in range.
+    auto const below = _mm256_set1_epi8(static_cast<char>(lo - 1));
+    auto const above = _mm256_set1_epi8(static_cast<char>(hi + 1));
+    auto const flip = _mm256_set1_epi8(0x20);
+
+    auto i = std::size_t{0};
+    for (; size - i >= 32; i += 32) {
+        auto const c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first + i));
+        auto const in_range =
+            _mm256_and_si256(_mm256_cmpgt_epi8(c, below), _mm256_cmpgt_epi8(above, c));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_xor_si256(c, _mm256_and_si256(in_range, flip)));
+    }
+    ascii_flip_case_sse2(first + i, size - i, out + i, lo, hi);
+}
+
+#endif  // ZZZ_SIMD_X86
+
+/// Copy [first, first + size) to \p out, flipping the case of bytes in [lo, hi].
+/** \p lo and \p hi bound an ASCII letter range, \p out may alias \p first. */
+inline void ascii_flip_case(char const* first,
+                            std::size_t size,
+                            char* out,
+                            char lo,
+                            char hi) noexcept
+{
+#if defined(ZZZ_SIMD_X86)
+    if (size >= 16) {
+        switch (detected_isa()) {
+            case Isa::AVX2: return ascii_flip_case_avx2(first, size, out, lo, hi);
+            case Isa::SSE2: return ascii_flip_case_sse2(first, size, out, lo, hi);
+            case Isa::Scalar: break;
+        }
+    }
+#endif
+    ascii_flip_case_scalar(first, size, out, lo, hi);
+}
+
+// character classes ---------------------------------------------------------------
+
+/// Return true if \p c is one of " \t\n\v\f\r".
+[[nodiscard]] constexpr auto is_ascii_whitespace(char c) noexcept -> bool
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/// Return pointer to the first byte in [first, last) for which is_ascii_whitespace
+/// is not \p negate; otherwise \p last.
+[[nodiscard]] inline auto find_whitespace_scalar(char const* first,
+                                                 char const* last,
+                                                 bool negate) noexcept -> char const*
+{
+    return std::find_if(first, last,
+                        [negate](char c) { return is_ascii_whitespace(c) != negate; });
+}
+
+/// Return the number of bytes in [first, last) within [lo, hi], both below 0x80.
+[[nodiscard]] inline auto count_in_range_scalar(char const* first,
+                                                char const* last,
+                                                char lo,
+                                                char hi) noexcept -> std::size_t
+{
+    return static_cast<std::size_t>(
+        std::count_if(first, last, [lo, hi](char c) { return c >= lo && c <= hi; }));
+}
+
+#if defined(ZZZ_SIMD_X86)
+
+/// Bitmask of the whitespace bytes in the 16 bytes at \p at.
+[[nodiscard]] __attribute__((target("sse2"))) inline auto match_whitespace_16(
+    char const* at) -> unsigned
+{
+    auto const c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(at));
+    auto const space = _mm_cmpeq_epi8(c, _mm_set1_epi8(' '));
+    auto const control = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('\t' - 1)),
+                                       _mm_cmplt_epi8(c, _mm_set1_epi8('\r' + 1)));
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(space, control)));
+}
+
+/// Bitmask of the whitespace bytes in the 32 bytes at \p at.
+[[nodiscard]] __attribute__((target("avx2"))) inline auto match_whitespace_32(
+    char const* at) -> unsigned
+{
+    auto const c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(at));
+    auto const space = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(' '));
+    auto const control =
+        _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('\t' - 1)),
+                         _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), c));
+    return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(space, control)));
+}
+
+[[nodiscard]] __attribute__((target("sse2"))) inline auto find_whitespace_sse2(
+    char const* first,
+    char const* last,
+    bool negate) -> char const*
+{
+    auto const flip = negate ? 0xFFFFu : 0u;
+    for (; last - first >= 16; first += 16) {
+        if (auto const mask = match_whitespace_16(first) ^ flip; mask != 0) {
+            return first + __builtin_ctz(mask);
+        }
+    }
+    return find_whitespace_scalar(first, last, negate);
+}
+
+[[nodiscard]] __attribute__((target("avx2"))) inline auto find_whitespace_avx2(
+    char const* first,
+    char const* last,
+    bool negate) -> char const*
+{
+    auto const flip = negate ? 0xFFFF'FFFFu : 0u;
+    for (; last - first >= 32; first += 32) {
+        if (auto const mask = match_whitespace_32(first) ^ flip; mask != 0) {
+            return first + __builtin_ctz(mask);
+        }
+    }
+    return find_whitespace_sse2(first, last, negate);
+}
+
+[[nodiscard]] __attribute__((target("sse2"))) inline auto count_in_range_sse2(
+    char const* first,
+    char const* last,
+    char lo,
+    char hi) -> std::size_t
+{
+    // Signed compares, bytes above 0x7f are negative and never in range.
+    auto const below = _mm_set1_epi8(static_cast<char>(lo - 1));
+    auto const above = _mm_set1_epi8(static_cast<char>(hi + 1));
+
+    auto count = std::size_t{0};
+    for (; last - first >= 16; first += 16) {
+        auto const c = _mm_loadu_si128(reinterpret_cast<__m128i const*>(first));
+        auto const in_range =
+            _mm_and_si128(_mm_cmpgt_epi8(c, below), _mm_cmplt_epi8(c, above));
+        count += static_cast<std::size_t>(
+            __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(in_range))));
+    }
+    return count + count_in_range_scalar(first, last, lo, hi);
+}
+
+[[nodiscard]] __attribute__((target("avx2,popcnt"))) inline auto count_in_range_avx2(
+    char const* first,
+    char const* last,
+    char lo,
+    char hi) -> std::size_t
+{
+    // Signed compares, bytes above 0x7f are negative and never in range.
+    auto const below = _mm256_set1_epi8(static_cast<char>(lo - 1));
+    auto const above = _mm256_set1_epi8(static_cast<char>(hi + 1));
+
+    auto count = std::size_t{0};
+    for (; last - first >= 32; first += 32) {
+        auto const c = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(first));
+        auto const in_range =
+            _mm256_and_si256(_mm256_cmpgt_epi8(c, below), _mm256_cmpgt_epi8(above, c));
+        count += static_cast<std::size_t>(
+            __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(in_range))));
+    }
+    return count + count_in_range_sse2(first, last, lo, hi);
+}
+
+#endif  // ZZZ_SIMD_X86
+
+/// Return pointer to the first byte in [first, last) for which is_ascii_whitespace
+/// is not \p negate; otherwise \p last.
+[[nodiscard]] inline auto find_whitespace(char const* first,
+                                          char const* last,
+                                          bool negate) -> char const*
+{
+#if defined(ZZZ_SIMD_X86)
+    if (last - first >= 16) {
+        switch (detected_isa()) {
+            case Isa::AVX2: return find_whitespace_avx2(first, last, negate);
+            case Isa::SSE2: return find_whitespace_sse2(first, last, negate);
+            case Isa::Scalar: break;
+        }
+    }
+#endif
+    return find_whitespace_scalar(first, last, negate);
+}
+
+/// Return the number of bytes in [first, last) within [lo, hi], both below 0x80.
+[[nodiscard]] inline auto count_in_range(char const* first,
+                                         char const* last,
+                                         char lo,
+                                         char hi) -> std::size_t
+{
+#if defined(ZZZ_SIMD_X86)
+    if (last - first >= 16) {
+        switch (detected_isa()) {
+            case Isa::AVX2: return count_in_range_avx2(first, last, lo, hi);
+            case Isa::SSE2: return count_in_range_sse2(first, last, lo, hi);
+            case Isa::Scalar: break;
+        }
+    }
+#endif
+    return count_in_range_scalar(first, last, lo, hi);
+}
+
+// find_value ----------------------------------------------------------------------
+
+/// Element types the find_value kernels compare lane by lane, with the semantics of
+/// operator==; floating point NaN never matches and -0.0 matches 0.0.
+template <typename T>
+concept SimdValue = std::is_arithmetic_v<T> && !std::same_as<T, bool> &&
+                    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                     sizeof(T) == 8);
+
+/// Return pointer to first \p value in [first, last); otherwise \p last.
+template <SimdValue T>
+[[nodiscard]] auto find_value_scalar(T const* first, T const* last, T value) -> T const*
+{
+    return std::find(first, last, value);
+}
+
+/// Set bit i % 64 of bits[i / 64] for each i in [from, size) where first[i] is
+/// \p value.
+template <SimdValue T>
+void find_all_values_scalar(T const* first,
+                            std::size_t from,
+                            std::size_t size,
+                            T value,
+                            std::uint64_t* bits)
+{
+    for (auto i = from; i < size; ++i) {
+        bits[i / 64] |= static_cast<std::uint64_t>(first[i] == value) << (i % 64);
+    }
+}
+
+#if defined(ZZZ_SIMD_X86)
+
+/// Bitmask of the elements equal to \p value in the 16 bytes at \p at, one bit per
+/// element.
+template <SimdValue T>
+[[nodiscard]] __attribute__((target("sse2"))) inline auto match_values_16(T const* at,
+                                                                          T value)
+    -> unsigned
+{
+    if constexpr (std::same_as<T, float>) {
+        return static_cast<unsigned>(
+            _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(at), _mm_set1_ps(value))));
+    }
+    else if constexpr (std::same_as<T, double>) {
+        return static_cast<unsigned>(
+            _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(at), _mm_set1_pd(value))));
+    }
+    else {
+        auto const x = _mm_loadu_si128(reinterpret_cast<__m128i const*>(at));
+        if constexpr (sizeof(T) == 1) {
+            auto const eq = _mm_cmpeq_epi8(x, _mm_set1_epi8(static_cast<char>(value)));
+            return static_cast<unsigned>(_mm_movemask_epi8(eq));
+        }
+        else if constexpr (sizeof(T) == 2) {
+            // Narrow each 16 bit lane to a byte so movemask yields one bit per lane.
+            auto const eq =
+                _mm_cmpeq_epi16(x, _mm_set1_epi16(static_cast<short>(value)));
+            return static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_packs_epi16(eq, _mm_setzero_si128())));
+        }
+        else if constexpr (sizeof(T) == 4) {
+            auto const eq = _mm_cmpeq_epi32(x, _mm_set1_epi32(static_cast<int>(value)));
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        }
+        else {
+            // SSE2 has no 64 bit compare, both 32 bit halves must match.
+            auto const eq32 =
+                _mm_cmpeq_epi32(x, _mm_set1_epi64x(static_cast<long long>(value)));
+            auto const eq =
+                _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+            return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(eq)));
+        }
+    }
+}
+
+/// Bitmask of the elements equal to \p value in the 32 bytes at \p at, one bit per
+/// element.
+template <SimdValue T>
+[[nodiscard]] __attribute__((target("avx2"))) inline auto match_values_32(T const* at,
+                                                                          T value)
+    -> unsigned
+{
+    if constexpr (std::same_as<T, float>) {
+        auto const eq = _mm256_cmp_ps(_mm256_loadu_ps(at), _mm256_set1_ps(value),
+                                      _CMP_EQ_OQ);
+        return static_cast<unsigned>(_mm256_movemask_ps(eq));
+    }
+    else if constexpr (std::same_as<T, double>) {
+        auto const eq = _mm256_cmp_pd(_mm256_loadu_pd(at), _mm256_set1_pd(value),
+                                      _CMP_EQ_OQ);
+        return static_cast<unsigned>(_mm256_movemask_pd(eq));
+    }
+    else {
+        auto const x = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(at));
+        if constexpr (sizeof(T) == 1) {
+            auto const eq =
+                _mm256_cmpeq_epi8(x, _mm256_set1_epi8(static_cast<char>(value)));
+            return static_cast<unsigned>(_mm256_movemask_epi8(eq));
+        }
+        else if constexpr (sizeof(T) == 2) {
+            // Packing works within 128 bit halves, each half's byte mask is doubled.
+            auto const eq =
+                _mm256_cmpeq_epi16(x, _mm256_set1_epi16(static_cast<short>(value)));
+            auto const mask =
+                static_cast<unsigned>(_mm256_movemask_epi8(_mm256_packs_epi16(eq, eq)));
+            return (mask & 0xFFu) | ((mask >> 8) & 0xFF00u);
+        }
+        else if constexpr (sizeof(T) == 4) {
+            auto const eq =
+                _mm256_cmpeq_epi32(x, _mm256_set1_epi32(static_cast<int>(value)));
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        }
+        else {
+            auto const eq = _mm256_cmpeq_epi64(
+                x, _mm256_set1_epi64x(static_cast<long long>(value)));
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(eq)));
+        }
+    }
+}
+
+template <SimdValue T>
+[[nodiscard]] __attribute__((target("sse2"))) inline auto find_value_sse2(
+    T const* first,
+    T const* last,
+    T value) -> T const*
+{
+    constexpr auto lanes = static_cast<std::ptrdiff_t>(16 / sizeof(T));
+    for (; last - first >= lanes; first += lanes) {
+        if (auto const mask = match_values_16(first, value); mask != 0) {
+            return first + std::countr_zero(mask);
+        }
+    }
+    return find_value_scalar(first, last, value);
+}
+
+template <SimdValue T>
+[[nodiscard]] __attribute__((target("avx2"))) inline auto find_value_avx2(
+    T const* first,
+    T const* last,
+    T value) -> T const*
+{
+    constexpr auto lanes = static_cast<std::ptrdiff_t>(32 / sizeof(T));
+    for (; last - first >= lanes; first += lanes) {
+        if (auto const mask = match_values_32(first, value); mask != 0) {
+            return first + std::countr_zero(mask);
+        }
+    }
+    return find_value_sse2(first, last, value);
+}
+
+/// \p from must be a multiple of the number of lanes, so a mask never straddles two
+/// words of \p bits.
+template <SimdValue T>
+__attribute__((target("sse2"))) inline void find_all_values_sse2(T const* first,
+                                                                 std::size_t from,
+                                                                 std::size_t size,
+                                                                 T value,
+                                                                 std::uint64_t* bits)
+{
+    constexpr auto lanes = 16 / sizeof(T);
+    auto i = from;
+    for (; i + lanes <= size; i += lanes) {
+        bits[i / 64] |= static_cast<std::uint64_t>(match_values_16(first + i, value))
+                        << (i % 64);
+    }
+    find_all_values_scalar(first, i, size, value, bits);
+}
+
+template <SimdValue T>
+__attribute__((target("avx2"))) inline void find_all_values_avx2(T const* first,
+                                                                 std::size_t from,
+                                                                 std::size_t size,
+                                                                 T value,
+                                                                 std::uint64_t* bits)
+{
+    constexpr auto lanes = 32 / sizeof(T);
+    auto i = from;
+    for (; i + lanes <= size; i += lanes) {
+        bits[i / 64] |= static_cast<std::uint64_t>(match_values_32(first + i, value))
+                        << (i % 64);
+    }
+    find_all_values_sse2(first, i, size, value, bits);
+}
+
+#endif  // ZZZ_SIMD_X86
+
+/// Return pointer to first \p value in [first, last); otherwise \p last.
+template <SimdValue T>
+[[nodiscard]] auto find_value(T const* first, T const* last, T value) -> T const*
+{
+#if defined(ZZZ_SIMD_X86)
+    if (last - first >= static_cast<std::ptrdiff_t>(16 / sizeof(T))) {
+        switch (detected_isa()) {
+            case Isa::AVX2: return find_value_avx2(first, last, value);
+            case Isa::SSE2: return find_value_sse2(first, last, value);
+            case Isa::Scalar: break;
+        }
+    }
+#endif
+    return find_value_scalar(first, last, value);
+}
+
+/// Set bit i % 64 of bits[i / 64] for each i in [0, size) where first[i] is \p value.
+/** \p bits must hold (size + 63) / 64 words, set to zero. */
+template <SimdValue T>
+void find_all_values(T const* first, std::size_t size, T value, std::uint64_t* bits)
+{
+#if defined(ZZZ_SIMD_X86)
+    switch (detected_isa()) {
+        case Isa::AVX2: return find_all_values_avx2(first, 0, size, value, bits);
+        case Isa::SSE2: return find_all_values_sse2(first, 0, size, value, bits);
+        case Isa::Scalar: break;
+    }
+#endif
+    find_all_values_scalar(first, 0, size, value, bits);
+}
+
+}  // namespace zzz::detail
@@ -1,11 +1,19 @@
 #pragma once
-#include <cctype>
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "./container.hpp"
+#include "./search.hpp"
+#include "./simd.hpp"
 
 namespace zzz {
 
@@ -21,6 +29,12 @@ namespace zzz {
     return find(x, segment) != std::cend(x);
 }
 
+/// Return true if there is at least one match of \p searcher in \p x.
+[[nodiscard]] inline auto contains(std::string_view x, Searcher const& searcher) -> bool
+{
+    return find(x, searcher) != std::cend(x);
+}
+
 /// Splits a string on \p delimiter, not including the delimiter in the result.
 /** Returns a string_view into the original string. Empty segments allowed.
  *  Empty \p delimiter throws std::runtime_error. */
@@ -30,23 +44,193 @@ namespace zzz {
     if (is_empty(delimiter))
         throw std::runtime_error{"zzz::split(...) Delimiter can't be empty."};
 
-    auto begin = std::cbegin(x);
+    auto const searcher = Searcher{delimiter};
     auto result = std::vector<std::string_view>{};
 
-    while (begin != std::cend(x)) {
-        auto const end = std::search(begin, std::cend(x), std::cbegin(delimiter),
-                                     std::cend(delimiter));
+    while (!is_empty(x)) {
+        auto const end = find(x, searcher);
+        auto const length =
+            static_cast<std::size_t>(std::distance(std::cbegin(x), end));
 
         // Empty segments are allowed, think csv.
-        result.emplace_back(std::addressof(*begin), std::distance(begin, end));
+        result.push_back(x.substr(0, length));
 
         // A delimiter was found and it is safe to increment length of delimiter
-        begin = (end != std::cend(x)) ? std::next(end, delimiter.size()) : end;
+        x.remove_prefix(end != std::cend(x) ? length + delimiter.size() : length);
     }
 
     return result;
 }
 
+namespace detail {
+
+/// String of up to \p Capacity chars stored inline, so that copies own their text.
+template <std::size_t Capacity>
+class InlineString {
+   public:
+    InlineString() noexcept = default;
+
+    /// \p x must be at most \p Capacity chars long.
+    explicit InlineString(std::string_view x) noexcept : size_{x.size()}
+    {
+        std::copy(x.begin(), x.end(), data_.begin());
+    }
+
+    [[nodiscard]] auto view() const noexcept -> std::string_view
+    {
+        return {data_.data(), size_};
+    }
+
+   private:
+    std::array<char, Capacity> data_{};
+    std::size_t size_{0};
+};
+
+}  // namespace detail
+
+/// Lazy view over the segments of a string split on a delimiter.
+/** Yields the same segments as zzz::split, one at a time. Each segment is a
+ *  string_view into the original string, which must outlive the view and its
+ *  iterators. The delimiter is copied, so it may be a temporary. Delimiters up to
+ *  Searcher::max_short_size are stored inline, in the view and in each iterator,
+ *  without an allocation. Longer ones are copied and compiled once into a Searcher
+ *  the copies of the view share, so iterators stay valid while any copy of the view
+ *  is alive. */
+class SplitView : public std::ranges::view_interface<SplitView> {
+    using ShortDelimiter = detail::InlineString<Searcher::max_short_size>;
+
+    /// A long delimiter and the Searcher compiled for it, which refers to it.
+    struct LongDelimiter {
+        explicit LongDelimiter(std::string_view x) : text{x}, searcher{text} {}
+
+        LongDelimiter(LongDelimiter const&) = delete;
+        auto operator=(LongDelimiter const&) -> LongDelimiter& = delete;
+
+        std::string text;
+        Searcher searcher;
+    };
+
+   public:
+    class Iterator {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::string_view;
+        using reference = std::string_view;
+        using pointer = void;
+
+        Iterator() noexcept = default;
+
+        /// Segment beginning at \p begin, \p last is the end of the whole string.
+        /** \p searcher is the compiled long delimiter, or nullptr to search for the
+         *  short \p delimiter directly. */
+        Iterator(char const* begin,
+                 char const* last,
+                 ShortDelimiter const& delimiter,
+                 Searcher const* searcher)
+            : begin_{begin}, end_{begin}, last_{last}, delimiter_{delimiter},
+              searcher_{searcher}
+        {
+            this->find_end();
+        }
+
+        auto operator++() -> Iterator&
+        {
+            auto const delimiter_size =
+                searcher_ ? searcher_->needle().size() : delimiter_.view().size();
+            // A delimiter was found and it is safe to increment length of delimiter
+            begin_ = (end_ != last_) ? end_ + delimiter_size : end_;
+            this->find_end();
+            return *this;
+        }
+
+        auto operator++(int) -> Iterator
+        {
+            auto tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        auto operator*() const -> std::string_view
+        {
+            return {begin_, static_cast<std::size_t>(end_ - begin_)};
+        }
+
+        auto operator==(Iterator const& other) const noexcept -> bool
+        {
+            return begin_ == other.begin_;
+        }
+
+       private:
+        void find_end()
+        {
+            if (begin_ == last_) { return; }
+            if (!searcher_) {
+                end_ = detail::find_segment(begin_, last_, delimiter_.view());
+                return;
+            }
+            auto const rest =
+                std::string_view{begin_, static_cast<std::size_t>(last_ - begin_)};
+            end_ = begin_ + std::distance(std::cbegin(rest), find(rest, *searcher_));
+        }
+
+       private:
+        char const* begin_{nullptr};
+        char const* end_{nullptr};
+        char const* last_{nullptr};
+        ShortDelimiter delimiter_;
+        Searcher const* searcher_{nullptr};
+    };
+
+   public:
+    SplitView() = default;
+
+    /// Empty \p delimiter throws std::runtime_error.
+    SplitView(std::string_view x, std::string_view delimiter) : x_{x}
+    {
+        if (is_empty(delimiter))
+            throw std::runtime_error{"zzz::split_view(...) Delimiter can't be empty."};
+        if (delimiter.size() > Searcher::max_short_size) {
+            long_delimiter_ = std::make_shared<LongDelimiter const>(delimiter);
+        }
+        else {
+            delimiter_ = ShortDelimiter{delimiter};
+        }
+    }
+
+    [[nodiscard]] auto begin() const -> Iterator
+    {
+        return {x_.data(), x_.data() + x_.size(), delimiter_, this->searcher()};
+    }
+
+    [[nodiscard]] auto end() const -> Iterator
+    {
+        auto const last = x_.data() + x_.size();
+        return {last, last, delimiter_, this->searcher()};
+    }
+
+   private:
+    [[nodiscard]] auto searcher() const noexcept -> Searcher const*
+    {
+        return long_delimiter_ ? &long_delimiter_->searcher : nullptr;
+    }
+
+   private:
+    std::string_view x_;
+    ShortDelimiter delimiter_{std::string_view{" "}};
+    std::shared_ptr<LongDelimiter const> long_delimiter_;
+};
+
+/// Lazily splits a string on \p delimiter, not including the delimiter in the result.
+/** Same segments as zzz::split, but computed on demand during iteration. \p x must
+ *  outlive the view, \p delimiter is copied. Empty \p delimiter throws
+ *  std::runtime_error. */
+[[nodiscard]] inline auto split_view(std::string_view x,
+                                     std::string_view delimiter = " ") -> SplitView
+{
+    return {x, delimiter};
+}
+
 /// Return a std::string_view substring of \p x.
 [[nodiscard]] inline auto substring(std::string_view x,
                                     std::size_t begin,
@@ -55,26 +239,58 @@ namespace zzz {
     return x.substr(begin, length);
 }
 
+/// Write \p x in all uppercase to \p out, return the written part of \p out.
+/** Only ASCII letters are converted, other bytes are copied unchanged. Never
+ *  allocates, \p out smaller than \p x throws std::runtime_error. */
+inline auto uppercase(std::string_view x, std::span<char> out) -> std::span<char>
+{
+    if (out.size() < x.size())
+        throw std::runtime_error{"zzz::uppercase(...) Output buffer is too small."};
+    detail::ascii_flip_case(x.data(), x.size(), out.data(), 'a', 'z');
+    return out.first(x.size());
+}
+
+/// Write \p x in all lowercase to \p out, return the written part of \p out.
+/** Only ASCII letters are converted, other bytes are copied unchanged. Never
+ *  allocates, \p out smaller than \p x throws std::runtime_error. */
+inline auto lowercase(std::string_view x, std::span<char> out) -> std::span<char>
+{
+    if (out.size() < x.size())
+        throw std::runtime_error{"zzz::lowercase(...) Output buffer is too small."};
+    detail::ascii_flip_case(x.data(), x.size(), out.data(), 'A', 'Z');
+    return out.first(x.size());
+}
+
+/// Convert \p x to all uppercase in place, e.g. a std::string or std::vector<char>.
+/** Only ASCII letters are converted, other bytes are unchanged. */
+inline void uppercase_in_place(std::span<char> x) noexcept
+{
+    detail::ascii_flip_case(x.data(), x.size(), x.data(), 'a', 'z');
+}
+
+/// Convert \p x to all lowercase in place, e.g. a std::string or std::vector<char>.
+/** Only ASCII letters are converted, other bytes are unchanged. */
+inline void lowercase_in_place(std::span<char> x) noexcept
+{
+    detail::ascii_flip_case(x.data(), x.size(), x.data(), 'A', 'Z');
+}
+
 /// Return \p x in all uppercase.
-[[nodiscard]] auto uppercase(std::string_view x) -> std::string
+/** Only ASCII letters are converted, other bytes are copied unchanged. */
+[[nodiscard]] inline auto uppercase(std::string_view x) -> std::string
 {
-    auto result = std::string{};
-    result.reserve(x.size());
-    for (auto c : x) {
-        result.push_back(static_cast<char>(std::toupper(c)));
-    }
+    auto result = std::string{x};
+    uppercase_in_place(result);
     return result;
 }
 
 /// Return \p x in all lowercase.
-[[nodiscard]] auto lowercase(std::string_view x) -> std::string
+/** Only ASCII letters are converted, other bytes are copied unchanged. */
+[[nodiscard]] inline auto lowercase(std::string_view x) -> std::string
 {
-    auto result = std::string{};
-    result.reserve(x.size());
-    for (auto c : x) {
-        result.push_back(static_cast<char>(std::tolower(c)));
-    }
+    auto result = std::string{x};
+    lowercase_in_place(result);
     return result;
 }
 
-}  // namespace zzz
\ No newline at end of file
+}  // namespace zzz
@@ -0,0 +1,484 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "./coro.hpp"
+
+namespace zzz {
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+/// Type a when_all holds the result of a Task<T> as, std::monostate for void.
+template <typename T>
+using NonVoid = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+/// Result of when_all over a vector of Task<T>, void for void tasks.
+template <typename T>
+using WhenAllVector =
+    std::conditional_t<std::is_void_v<T>, void, std::vector<NonVoid<T>>>;
+
+template <typename T>
+auto take_result(Task<T>& task) -> NonVoid<T>;
+
+/// Promise parts common to every Task, the frame and the continuation.
+class TaskPromiseBase {
+   public:
+    /// Resumes the awaiting coroutine when the task finishes.
+    struct FinalAwaiter {
+        auto await_ready() noexcept -> bool { return false; }
+
+        template <typename Promise>
+        auto await_suspend(std::coroutine_handle<Promise> handle) noexcept
+            -> std::coroutine_handle<>
+        {
+            auto const continuation = handle.promise().continuation_;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    auto initial_suspend() noexcept { return std::suspend_always{}; }
+
+    auto final_suspend() noexcept { return FinalAwaiter{}; }
+
+    [[nodiscard]] static auto operator new(std::size_t size) -> void*
+    {
+        return allocate_frame(size);
+    }
+
+    static void operator delete(void* frame, std::size_t size) noexcept
+    {
+        deallocate_frame(frame, size);
+    }
+
+    /// Coroutine awaiting the task; nullptr if none.
+    std::coroutine_handle<> continuation_{nullptr};
+};
+
+template <typename T>
+class TaskPromise : public TaskPromiseBase {
+   public:
+    template <typename U = T>
+        requires std::convertible_to<U&&, T>
+    void return_value(U&& value)
+    {
+        if constexpr (std::is_reference_v<T>)
+            result_.template emplace<1>(std::addressof(value));
+        else
+            result_.template emplace<1>(std::forward<U>(value));
+    }
+
+    void unhandled_exception() noexcept
+    {
+        result_.template emplace<2>(std::current_exception());
+    }
+
+    auto result() & -> std::conditional_t<std::is_reference_v<T>, T, T&>
+    {
+        rethrow_if_failed();
+        if constexpr (std::is_reference_v<T>)
+            return static_cast<T>(*std::get<1>(result_));
+        else
+            return std::get<1>(result_);
+    }
+
+    auto result() && -> T
+    {
+        rethrow_if_failed();
+        if constexpr (std::is_reference_v<T>)
+            return static_cast<T>(*std::get<1>(result_));
+        else
+            return std::move(std::get<1>(result_));
+    }
+
+   private:
+    void rethrow_if_failed() const
+    {
+        if (result_.index() == 2) { std::rethrow_exception(std::get<2>(result_)); }
+    }
+
+    /// References are held as pointers.
+    using Stored =
+        std::conditional_t<std::is_reference_v<T>, std::remove_reference_t<T>*, T>;
+
+    std::variant<std::monostate, Stored, std::exception_ptr> result_;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase {
+   public:
+    void return_void() noexcept {}
+
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    void result() const
+    {
+        if (exception_) { std::rethrow_exception(exception_); }
+    }
+
+   private:
+    std::exception_ptr exception_{nullptr};
+};
+
+/**
+ * @brief Coroutine that starts a task and tells \p Signal when it is done, for
+ * when_all and sync_wait.
+ * @details Signal::arrive() returns the coroutine to resume next, it is called once
+ * the coroutine is suspended, so the signal may destroy it.
+ */
+template <typename Signal>
+class SignalTask {
+   public:
+    struct promise_type {
+        struct FinalAwaiter {
+            auto await_ready() noexcept -> bool { return false; }
+
+            auto await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+                -> std::coroutine_handle<>
+            {
+                return handle.promise().signal_->arrive();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        auto get_return_object()
+        {
+            return SignalTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        auto initial_suspend() noexcept { return std::suspend_always{}; }
+
+        auto final_suspend() noexcept { return FinalAwaiter{}; }
+
+        void return_void() noexcept {}
+
+        // The task awaited with when_ready() holds its own exception.
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        [[nodiscard]] static auto operator new(std::size_t size) -> void*
+        {
+            return allocate_frame(size);
+        }
+
+        static void operator delete(void* frame, std::size_t size) noexcept
+        {
+            deallocate_frame(frame, size);
+        }
+
+        Signal* signal_{nullptr};
+    };
+
+   public:
+    explicit SignalTask(std::coroutine_handle<promise_type> handle) noexcept
+        : handle_{handle}
+    {}
+
+    SignalTask(SignalTask const&) = delete;
+    auto operator=(SignalTask const&) -> SignalTask& = delete;
+
+    SignalTask(SignalTask&& other) noexcept
+        : handle_{std::exchange(other.handle_, nullptr)}
+    {}
+
+    auto operator=(SignalTask&&) -> SignalTask& = delete;
+
+    ~SignalTask()
+    {
+        if (handle_) { handle_.destroy(); }
+    }
+
+    /// Run the task until it first suspends, \p signal is told when it is done.
+    void start(Signal& signal)
+    {
+        handle_.promise().signal_ = &signal;
+        handle_.resume();
+    }
+
+   private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename Signal, typename T>
+auto signal_when_ready(Task<T>& task) -> SignalTask<Signal>
+{
+    co_await task.when_ready();
+}
+
+/// Counts the tasks of a when_all down, the last one to finish resumes the awaiter.
+class WhenAllLatch {
+   public:
+    /// Count \p count tasks, and one more for the awaiter so none resumes it early.
+    explicit WhenAllLatch(std::size_t count) noexcept : count_{count + 1} {}
+
+    /// Set \p awaiter to resume when all tasks are done, return true if it must
+    /// suspend, false if they are done already.
+    auto try_await(std::coroutine_handle<> awaiter) noexcept -> bool
+    {
+        awaiter_ = awaiter;
+        return count_.fetch_sub(1, std::memory_order_acq_rel) > 1;
+    }
+
+    auto arrive() noexcept -> std::coroutine_handle<>
+    {
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) { return awaiter_; }
+        return std::noop_coroutine();
+    }
+
+   private:
+    std::atomic<std::size_t> count_;
+    std::coroutine_handle<> awaiter_{nullptr};
+};
+
+/// Starts each task and suspends the awaiter until all of them are done.
+struct WhenAllAwaiter {
+    auto await_ready() noexcept -> bool { return tasks.empty(); }
+
+    auto await_suspend(std::coroutine_handle<> handle) -> bool
+    {
+        for (auto& task : tasks) {
+            task.start(latch);
+        }
+        return latch.try_await(handle);
+    }
+
+    void await_resume() noexcept {}
+
+    std::span<SignalTask<WhenAllLatch>> tasks;
+    WhenAllLatch& latch;
+};
+
+/// Wakes the thread blocked in sync_wait.
+class SyncWaitEvent {
+   public:
+    auto arrive() noexcept -> std::coroutine_handle<>
+    {
+        // Notify while holding the lock, the waiter may destroy the event as soon as
+        // it can lock the mutex.
+        auto const lock = std::lock_guard{mutex_};
+        done_ = true;
+        ready_.notify_one();
+        return std::noop_coroutine();
+    }
+
+    void wait()
+    {
+        auto lock = std::unique_lock{mutex_};
+        ready_.wait(lock, [this] { return done_; });
+    }
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    bool done_{false};
+};
+
+}  // namespace detail
+
+/**
+ * @brief Lazily started coroutine that produces a T, or void, when awaited.
+ * @details The task starts when it is first awaited, `co_await task` or `co_await
+ * std::move(task)` to take the result, and resumes its awaiter by symmetric transfer
+ * when it finishes, so in optimized builds chains of tasks don't grow the stack. An
+ * exception that escapes the task is rethrown to its awaiter. Frames come from the
+ * same thread local pool as Generator frames. Run tasks on a zzz::Scheduler with
+ * `co_await scheduler.schedule()`, and wait for one outside of any coroutine with
+ * sync_wait.
+ */
+template <typename T = void>
+class [[nodiscard]] Task {
+   public:
+    struct promise_type : detail::TaskPromise<T> {
+        auto get_return_object() noexcept
+        {
+            return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+    using value_type = T;
+
+   public:
+    /// Create an empty task, awaiting it throws std::runtime_error.
+    Task() noexcept = default;
+
+    explicit Task(handle_type handle) noexcept : handle_{handle} {}
+
+    Task(Task const&) = delete;
+    auto operator=(Task const&) -> Task& = delete;
+
+    Task(Task&& other) noexcept : handle_{std::exchange(other.handle_, nullptr)} {}
+
+    auto operator=(Task&& other) noexcept -> Task&
+    {
+        if (this != &other) {
+            if (handle_) { handle_.destroy(); }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task()
+    {
+        if (handle_) { handle_.destroy(); }
+    }
+
+   public:
+    /// Return true if the task has finished.
+    [[nodiscard]] auto is_ready() const noexcept -> bool
+    {
+        return !handle_ || handle_.done();
+    }
+
+    /// Await the task, returns a reference to its result.
+    auto operator co_await() & noexcept { return Awaiter<false>{handle_}; }
+
+    /// Await the task, returns its result.
+    auto operator co_await() && noexcept { return Awaiter<true>{handle_}; }
+
+    /// Return an awaitable that runs the task to completion without taking its
+    /// result or rethrowing its exception.
+    [[nodiscard]] auto when_ready() noexcept
+    {
+        struct ReadyAwaiter : Awaiter<false> {
+            void await_resume() const noexcept {}
+        };
+        return ReadyAwaiter{{handle_}};
+    }
+
+   private:
+    template <bool Move>
+    struct Awaiter {
+        auto await_ready() const noexcept -> bool { return !handle || handle.done(); }
+
+        auto await_suspend(std::coroutine_handle<> awaiter) noexcept
+            -> std::coroutine_handle<>
+        {
+            handle.promise().continuation_ = awaiter;
+            return handle;
+        }
+
+        auto await_resume() -> decltype(auto)
+        {
+            if (!handle) {
+                throw std::runtime_error{"zzz::Task Awaited an empty task."};
+            }
+            if constexpr (Move)
+                return std::move(handle.promise()).result();
+            else
+                return handle.promise().result();
+        }
+
+        handle_type handle;
+    };
+
+    template <typename U>
+    friend auto detail::take_result(Task<U>& task) -> detail::NonVoid<U>;
+
+   private:
+    handle_type handle_{nullptr};
+};
+
+namespace detail {
+
+/// Take the result of a finished \p task, std::monostate if it returns void.
+template <typename T>
+auto take_result(Task<T>& task) -> NonVoid<T>
+{
+    if (!task.handle_) {
+        throw std::runtime_error{"zzz::when_all Awaited an empty task."};
+    }
+    if constexpr (std::is_void_v<T>) {
+        task.handle_.promise().result();
+        return {};
+    }
+    else {
+        return std::move(task.handle_.promise()).result();
+    }
+}
+
+}  // namespace detail
+
+/// Return a task that runs each of \p tasks and returns a tuple of their results,
+/// std::monostate for void tasks.
+/** The tasks start one after the other on the awaiting thread, each runs until it
+ *  first suspends, e.g. on `co_await scheduler.schedule()`, so they run concurrently
+ *  if they are scheduled. The task resumes on the thread of the task that finished
+ *  last. The first exception of \p tasks, in order, is rethrown once all are done. */
+template <typename... Ts>
+auto when_all(Task<Ts>... tasks) -> Task<std::tuple<detail::NonVoid<Ts>...>>
+{
+    using Signal = detail::WhenAllLatch;
+    auto latch = Signal{sizeof...(Ts)};
+    auto signals = std::array<detail::SignalTask<Signal>, sizeof...(Ts)>{
+        detail::signal_when_ready<Signal>(tasks)...};
+    co_await detail::WhenAllAwaiter{signals, latch};
+    co_return std::tuple<detail::NonVoid<Ts>...>{detail::take_result(tasks)...};
+}
+
+/// Return a task that runs each of \p tasks and returns a vector of their results,
+/// as with the variadic when_all; returns void for void tasks.
+template <typename T>
+auto when_all(std::vector<Task<T>> tasks)
+    -> Task<detail::WhenAllVector<T>>
+{
+    using Signal = detail::WhenAllLatch;
+    auto latch = Signal{tasks.size()};
+    auto signals = std::vector<detail::SignalTask<Signal>>{};
+    signals.reserve(tasks.size());
+    for (auto& task : tasks) {
+        signals.push_back(detail::signal_when_ready<Signal>(task));
+    }
+    co_await detail::WhenAllAwaiter{signals, latch};
+
+    if constexpr (std::is_void_v<T>) {
+        for (auto& task : tasks) {
+            detail::take_result(task);
+        }
+    }
+    else {
+        auto results = std::vector<T>{};
+        results.reserve(tasks.size());
+        for (auto& task : tasks) {
+            results.push_back(detail::take_result(task));
+        }
+        co_return results;
+    }
+}
+
+/// Block the calling thread until \p task is done and return its result.
+/** Must not be called from a worker of the scheduler the task runs on, which would
+ *  then wait for itself. */
+template <typename T>
+auto sync_wait(Task<T> task) -> T
+{
+    auto event = detail::SyncWaitEvent{};
+    auto signal = detail::signal_when_ready<detail::SyncWaitEvent>(task);
+    signal.start(event);
+    event.wait();
+    if constexpr (std::is_void_v<T>)
+        detail::take_result(task);
+    else
+        return detail::take_result(task);
+}
+
+}  // namespace zzz
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <latch>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "./work_stealing_executor.hpp"
+
+namespace zzz {
+
+namespace detail {
+
+/// Type erased function a ThreadPool runs once and then deletes.
+/** Allocated with plain new: a job is mostly freed by another thread than the one
+ *  that posted it, so a thread local cache such as FramePool would never get its
+ *  blocks back. */
+struct PoolJob {
+    virtual ~PoolJob() = default;
+    virtual void run() noexcept = 0;
+};
+
+template <typename F>
+struct PoolJobFor final : PoolJob {
+    explicit PoolJobFor(F&& fn) : fn{std::move(fn)} {}
+
+    void run() noexcept override { fn(); }
+
+    F fn;
+};
+
+/// Run a PoolJob and delete it.
+struct RunPoolJob {
+    void operator()(PoolJob* job) const noexcept
+    {
+        job->run();
+        delete job;
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Thread pool that runs functions, `submit(fn)` returns a std::future of the
+ * result of fn().
+ * @details The workers are a detail::WorkStealingExecutor: a job posted from a
+ * worker stays on that worker unless an idle one steals it, and idle workers sleep
+ * until new work is posted.
+ *
+ * Waiting on the future of a job from another job may deadlock, as the waiting
+ * worker doesn't run other jobs meanwhile; parallel_for does.
+ *
+ * The destructor waits for the workers to run every posted job, including those
+ * posted meanwhile, and then joins them.
+ */
+class ThreadPool {
+   public:
+    /// Tuning of a ThreadPool.
+    struct Options {
+        /// Pin the i-th worker to the i-th CPU the process may run on, modulo their
+        /// count, so that it keeps its caches. Only on Linux, ignored elsewhere.
+        bool pin_threads{false};
+    };
+
+   public:
+    /// Start \p thread_count workers, at least one; one per hardware thread if zero.
+    explicit ThreadPool(std::size_t thread_count = 0)
+        : ThreadPool(thread_count, Options{})
+    {}
+
+    /// Start \p thread_count workers, at least one; one per hardware thread if zero.
+    ThreadPool(std::size_t thread_count, Options options)
+        : executor_{thread_count, options.pin_threads}
+    {}
+
+    ThreadPool(ThreadPool const&) = delete;
+    auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+
+   public:
+    /// Run \p fn() on a worker, return a future of its result or exception.
+    template <typename F, typename R = std::invoke_result_t<std::decay_t<F>&>>
+    [[nodiscard]] auto submit(F&& fn) -> std::future<R>
+    {
+        auto task = std::packaged_task<R()>{std::forward<F>(fn)};
+        auto future = task.get_future();
+        post(std::move(task));
+        return future;
+    }
+
+    /// Run \p fn() on a worker, without a way to wait for it.
+    /** \p fn must not throw, std::terminate is called if it does. */
+    template <typename F>
+    void post(F&& fn)
+    {
+        using Fn = std::decay_t<F>;
+        auto job = std::make_unique<detail::PoolJobFor<Fn>>(Fn{std::forward<F>(fn)});
+        executor_.push(job.get());
+        job.release();
+    }
+
+    /**
+     * Call \p fn(i) for each i in [\p first, \p last) on the workers and the calling
+     * thread, and wait for all.
+     * @details The indices are handed out in chunks of \p grain, or of a size that
+     * makes some chunks per worker if zero, to whichever thread is free first. The
+     * calling thread may be a worker, it runs other jobs while it waits. The first
+     * exception thrown by \p fn is rethrown, no new chunks start after it.
+     */
+    template <typename F>
+    void parallel_for(std::size_t first,
+                      std::size_t last,
+                      F const& fn,
+                      std::size_t grain = 0)
+    {
+        if (first >= last) { return; }
+        auto const count = last - first;
+        if (grain == 0) {
+            auto const target = chunks_per_worker * thread_count();
+            grain = std::max<std::size_t>(count / target, 1);
+        }
+        auto const chunks = (count + grain - 1) / grain;
+        auto const helpers = std::min(chunks - 1, thread_count());
+
+        auto state = ParallelFor<F>{fn, first, last, grain, helpers};
+        for (auto i = std::size_t{0}; i < helpers; ++i) {
+            post([&state] {
+                state.run();
+                state.done.count_down();
+            });
+        }
+        state.run();
+
+        if (executor_.is_worker()) {
+            while (!state.done.try_wait()) {
+                if (!executor_.run_one()) { std::this_thread::yield(); }
+            }
+        }
+        else {
+            state.done.wait();
+        }
+        if (state.error) { std::rethrow_exception(state.error); }
+    }
+
+    /// Return the number of worker threads.
+    [[nodiscard]] auto thread_count() const noexcept -> std::size_t
+    {
+        return executor_.thread_count();
+    }
+
+   private:
+    /// The indices of a parallel_for that are left, shared by the threads running it.
+    template <typename F>
+    struct ParallelFor {
+        ParallelFor(F const& fn,
+                    std::size_t first,
+                    std::size_t last,
+                    std::size_t grain,
+                    std::size_t helpers)
+            : fn{fn}, next{first}, last{last}, grain{grain},
+              done{static_cast<std::ptrdiff_t>(helpers)}
+        {}
+
+        /// Run chunks until none are left.
+        void run() noexcept
+        {
+            while (true) {
+                auto const begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (begin >= last) { return; }
+                auto const end = std::min(begin + grain, last);
+                try {
+                    for (auto i = begin; i < end; ++i) {
+                        fn(i);
+                    }
+                }
+                catch (...) {
+                    if (!failed.test_and_set()) { error = std::current_exception(); }
+                    next.store(last, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        }
+
+        F const& fn;
+        std::atomic<std::size_t> next;
+        std::size_t last;
+        std::size_t grain;
+        std::latch done;
+        std::atomic_flag failed;
+        std::exception_ptr error{nullptr};
+    };
+
+    /// Chunks parallel_for splits the indices into per worker, by default.
+    static constexpr std::size_t chunks_per_worker = 8;
+
+   private:
+    detail::WorkStealingExecutor<detail::PoolJob*, detail::RunPoolJob> executor_;
+};
+
+}  // namespace zzz
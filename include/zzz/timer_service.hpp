@@ -0,0 +1,463 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace zzz {
+
+/**
+ * @brief Runs any number of one-shot and periodic timers on a single thread.
+ * @details Timers live in a hierarchical timing wheel: six levels of 64 slots, each
+ * level's slots spanning 64 times the ticks of the level below. A timer goes to the
+ * coarsest level that still tells its tick apart from the current one, and moves
+ * down a level each time the wheel reaches its slot, so scheduling and cancelling
+ * are O(1) and each timer is moved at most five times. The thread sleeps until the
+ * next non-empty slot, found from a bitmap of the slots per level, rather than
+ * waking up every tick.
+ *
+ * Timers fire on the first tick at or after their deadline, i.e. up to one tick
+ * late. Callbacks run on the service's thread, one after the other, so they should
+ * be short or hand their work to another thread. A periodic timer whose callback
+ * overran one or more periods skips them rather than firing repeatedly to catch up.
+ */
+class TimerService {
+   public:
+    using CallbackType = std::function<void()>;
+    using ClockType = std::chrono::steady_clock;
+
+    class Handle;
+
+    static constexpr std::size_t level_count = 6;
+    static constexpr std::size_t slot_bits = 6;
+    static constexpr std::size_t slot_count = std::size_t{1} << slot_bits;
+
+   public:
+    /**
+     * Start the service's thread.
+     * @param tick The resolution of the timers, deadlines are rounded up to it
+     */
+    explicit TimerService(ClockType::duration tick = std::chrono::milliseconds{1})
+        : tick_{std::max(tick, ClockType::duration{1})}, start_{ClockType::now()}
+    {
+        heads_.fill(npos);
+        thread_ = std::jthread{[this](std::stop_token st) { run(st); }};
+    }
+
+    TimerService(TimerService const&) = delete;
+    auto operator=(TimerService const&) -> TimerService& = delete;
+
+    /// Stop the thread, pending timers don't fire; handles must be gone by now.
+    ~TimerService()
+    {
+        thread_.request_stop();
+        thread_.join();
+    }
+
+   public:
+    /**
+     * Call \p callback once, after \p delay.
+     * @return A handle that cancels the timer when destroyed, unless released
+     */
+    [[nodiscard]] auto schedule_after(ClockType::duration delay, CallbackType callback)
+        -> Handle;
+
+    /**
+     * Call \p callback every \p period, the first time after one period.
+     * @return A handle that cancels the timer when destroyed, unless released
+     */
+    [[nodiscard]] auto schedule_every(ClockType::duration period, CallbackType callback)
+        -> Handle;
+
+    /// Return the number of timers that have yet to fire, or fire again.
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        auto const lock = std::lock_guard{mutex_};
+        return size_;
+    }
+
+    /// Return the resolution of the timers.
+    [[nodiscard]] auto tick() const noexcept -> ClockType::duration { return tick_; }
+
+   private:
+    static constexpr auto npos = std::numeric_limits<std::uint32_t>::max();
+    static constexpr auto never = std::numeric_limits<std::uint64_t>::max();
+
+    enum class State : std::uint8_t { Free, Pending, Firing, Cancelled };
+
+    struct Node {
+        CallbackType callback;
+        std::uint64_t expiry{0};
+        /// Ticks between firings; 0 for a one-shot timer.
+        std::uint64_t period{0};
+        std::uint32_t prev{npos};
+        std::uint32_t next{npos};
+        std::uint32_t generation{0};
+        std::uint16_t slot{0};
+        State state{State::Free};
+    };
+
+    /// A timer to fire, the node is kept as a pointer to call it without the lock.
+    struct Due {
+        std::uint32_t index;
+        Node* node;
+    };
+
+    auto add(ClockType::duration delay, std::uint64_t period, CallbackType callback)
+        -> Handle;
+
+    auto cancel(std::uint32_t index, std::uint32_t generation) -> bool;
+
+    [[nodiscard]] auto is_pending(std::uint32_t index, std::uint32_t generation) const
+        -> bool
+    {
+        auto const lock = std::lock_guard{mutex_};
+        auto const& node = nodes_[index];
+        return node.generation == generation && node.state == State::Pending;
+    }
+
+    /// Return the tick of \p time, rounded down.
+    [[nodiscard]] auto tick_of(ClockType::time_point time) const -> std::uint64_t
+    {
+        return time <= start_ ? 0 : static_cast<std::uint64_t>((time - start_) / tick_);
+    }
+
+    /// Return the tick of \p time, rounded up.
+    [[nodiscard]] auto tick_after(ClockType::time_point time) const -> std::uint64_t
+    {
+        return time <= start_ ? 0 : ticks_in(time - start_);
+    }
+
+    /// Return the number of ticks in \p duration, rounded up.
+    [[nodiscard]] auto ticks_in(ClockType::duration duration) const -> std::uint64_t
+    {
+        if (duration <= ClockType::duration::zero()) { return 0; }
+        return static_cast<std::uint64_t>((duration + tick_ - ClockType::duration{1}) /
+                                          tick_);
+    }
+
+    /// Link node \p i into the slot its expiry belongs to, given the current tick.
+    void insert(std::uint32_t i)
+    {
+        auto& node = nodes_[i];
+        node.expiry = std::max(node.expiry, current_);
+
+        constexpr auto max_ticks = std::uint64_t{1} << (slot_bits * level_count);
+        auto const distance = std::min(node.expiry - current_, max_ticks - 1);
+        auto const level =
+            distance < slot_count ? 0 : (std::bit_width(distance) - 1) / slot_bits;
+        auto const tick = current_ + distance;
+        auto const slot = (tick >> (slot_bits * level)) & (slot_count - 1);
+
+        node.slot = static_cast<std::uint16_t>(level * slot_count + slot);
+        node.prev = npos;
+        node.next = heads_[node.slot];
+        if (node.next != npos) { nodes_[node.next].prev = i; }
+        heads_[node.slot] = i;
+        occupied_[level] |= std::uint64_t{1} << slot;
+    }
+
+    void unlink(std::uint32_t i)
+    {
+        auto& node = nodes_[i];
+        if (node.prev != npos)
+            nodes_[node.prev].next = node.next;
+        else
+            heads_[node.slot] = node.next;
+        if (node.next != npos) { nodes_[node.next].prev = node.prev; }
+
+        if (heads_[node.slot] == npos) {
+            occupied_[node.slot / slot_count] &=
+                ~(std::uint64_t{1} << (node.slot % slot_count));
+        }
+    }
+
+    /// Detach and return the list of timers in \p slot.
+    auto take_slot(std::size_t slot) -> std::uint32_t
+    {
+        auto const head = std::exchange(heads_[slot], npos);
+        occupied_[slot / slot_count] &= ~(std::uint64_t{1} << (slot % slot_count));
+        return head;
+    }
+
+    /// Return the first tick from the current one at which a slot must be cascaded
+    /// or fired; never if the wheel is empty.
+    [[nodiscard]] auto next_event() const -> std::uint64_t
+    {
+        auto result = never;
+        for (auto level = std::size_t{0}; level < level_count; ++level) {
+            if (occupied_[level] == 0) { continue; }
+            auto const shift = slot_bits * level;
+            auto const base = current_ >> shift;
+            auto const aligned = (current_ & ((std::uint64_t{1} << shift) - 1)) == 0;
+            auto const bits = std::rotr(occupied_[level],
+                                        static_cast<int>(base & (slot_count - 1)));
+
+            // The current slot of an upper level was cascaded when the wheel entered
+            // it, timers in it now are due on its next turn.
+            auto offset = std::uint64_t{slot_count};
+            if (aligned && (bits & 1) != 0)
+                offset = 0;
+            else if (auto const later = bits & ~std::uint64_t{1}; later != 0)
+                offset = static_cast<std::uint64_t>(std::countr_zero(later));
+
+            result = std::min(result, (base + offset) << shift);
+        }
+        return result;
+    }
+
+    /// Advance the wheel to the current tick, and append the timers due to \p due.
+    void process(std::vector<Due>& due)
+    {
+        // Upper levels first, so a timer can move down several levels at once.
+        for (auto level = level_count - 1; level != 0; --level) {
+            auto const shift = slot_bits * level;
+            if ((current_ & ((std::uint64_t{1} << shift) - 1)) != 0) { continue; }
+            auto const slot = (current_ >> shift) & (slot_count - 1);
+            for (auto i = take_slot(level * slot_count + slot); i != npos;) {
+                auto const next = nodes_[i].next;
+                insert(i);
+                i = next;
+            }
+        }
+        for (auto i = take_slot(current_ & (slot_count - 1)); i != npos;) {
+            auto& node = nodes_[i];
+            node.state = State::Firing;
+            due.push_back({i, &node});
+            i = node.next;
+        }
+        ++current_;
+    }
+
+    void release_node(Node& node, std::uint32_t i)
+    {
+        node.callback = nullptr;
+        node.state = State::Free;
+        ++node.generation;
+        free_.push_back(i);
+        --size_;
+    }
+
+    void run(std::stop_token st)
+    {
+        auto due = std::vector<Due>{};
+        auto lock = std::unique_lock{mutex_};
+        while (!st.stop_requested()) {
+            auto const next = next_event();
+            if (next > tick_of(ClockType::now())) {
+                wake_tick_ = next;
+                auto const woken = [&] { return wake_tick_ != next; };
+                if (next == never)
+                    wake_.wait(lock, st, woken);
+                else
+                    wake_.wait_until(lock, st, start_ + next * tick_, woken);
+                continue;
+            }
+
+            current_ = next;
+            process(due);
+            if (due.empty()) { continue; }
+
+            lock.unlock();
+            for (auto [i, node] : due) {
+                node->callback();
+            }
+            lock.lock();
+
+            // The callbacks may have overrun periods, the wheel is still behind them.
+            auto const now = tick_of(ClockType::now());
+            for (auto [i, node] : due) {
+                if (node->state == State::Cancelled || node->period == 0) {
+                    release_node(*node, i);
+                    continue;
+                }
+                node->state = State::Pending;
+                node->expiry += node->period;
+                if (node->expiry < now) {
+                    auto const missed =
+                        (now - node->expiry + node->period - 1) / node->period;
+                    node->expiry += missed * node->period;
+                }
+                insert(i);
+            }
+            due.clear();
+        }
+    }
+
+   private:
+    ClockType::duration tick_;
+    ClockType::time_point start_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any wake_;
+
+    /// Timers by index, a deque so that firing timers stay put while others are added.
+    std::deque<Node> nodes_;
+    std::vector<std::uint32_t> free_;
+    std::size_t size_{0};
+
+    std::array<std::uint32_t, level_count * slot_count> heads_;
+    std::array<std::uint64_t, level_count> occupied_{};
+
+    /// The tick the wheel is at, timers due then have yet to fire.
+    std::uint64_t current_{0};
+    /// The tick the thread sleeps until; never if it waits for a timer.
+    std::uint64_t wake_tick_{never};
+
+    // Declared last, so the thread is started after the state it uses is ready.
+    std::jthread thread_;
+};
+
+/**
+ * @brief Owns a timer of a TimerService, cancels it when destroyed.
+ * @details A handle must not outlive its service.
+ */
+class TimerService::Handle {
+   public:
+    /// Create a handle without a timer.
+    Handle() noexcept = default;
+
+    Handle(Handle const&) = delete;
+    auto operator=(Handle const&) -> Handle& = delete;
+
+    Handle(Handle&& other) noexcept
+        : service_{std::exchange(other.service_, nullptr)},
+          index_{other.index_},
+          generation_{other.generation_}
+    {}
+
+    auto operator=(Handle&& other) noexcept -> Handle&
+    {
+        if (this != &other) {
+            cancel();
+            service_ = std::exchange(other.service_, nullptr);
+            index_ = other.index_;
+            generation_ = other.generation_;
+        }
+        return *this;
+    }
+
+    ~Handle() { cancel(); }
+
+   public:
+    /**
+     * Cancel the timer, it doesn't fire after this returns, unless it is firing on
+     * the service's thread right now.
+     * @return True if the timer was pending, false if it had already fired, been
+     * cancelled, or released
+     */
+    auto cancel() -> bool
+    {
+        if (service_ == nullptr) { return false; }
+        return std::exchange(service_, nullptr)->cancel(index_, generation_);
+    }
+
+    /// Let the timer run until it fires, or until the service is destroyed for a
+    /// periodic timer, without the handle.
+    void release() noexcept { service_ = nullptr; }
+
+    /// Return true if the timer has yet to fire, or fire again.
+    [[nodiscard]] auto is_pending() const -> bool
+    {
+        return service_ != nullptr && service_->is_pending(index_, generation_);
+    }
+
+   private:
+    friend TimerService;
+
+    Handle(TimerService* service, std::uint32_t index, std::uint32_t generation)
+        : service_{service}, index_{index}, generation_{generation}
+    {}
+
+    TimerService* service_{nullptr};
+    std::uint32_t index_{0};
+    std::uint32_t generation_{0};
+};
+
+inline auto TimerService::schedule_after(ClockType::duration delay,
+                                         CallbackType callback) -> Handle
+{
+    return add(delay, 0, std::move(callback));
+}
+
+inline auto TimerService::schedule_every(ClockType::duration period,
+                                         CallbackType callback) -> Handle
+{
+    return add(period, std::max<std::uint64_t>(ticks_in(period), 1),
+               std::move(callback));
+}
+
+inline auto TimerService::add(ClockType::duration delay,
+                              std::uint64_t period,
+                              CallbackType callback) -> Handle
+{
+    auto const deadline = ClockType::now() + delay;
+    auto notify = false;
+    auto handle = Handle{};
+    {
+        auto const lock = std::lock_guard{mutex_};
+        if (size_ == 0) {
+            // Nothing is linked, skip the ticks the wheel slept through.
+            current_ = std::max(current_, tick_of(ClockType::now()));
+        }
+
+        auto i = std::uint32_t{0};
+        if (free_.empty()) {
+            i = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+        }
+        else {
+            i = free_.back();
+            free_.pop_back();
+        }
+
+        auto& node = nodes_[i];
+        node.callback = std::move(callback);
+        node.expiry = tick_after(deadline);
+        node.period = period;
+        node.state = State::Pending;
+        insert(i);
+        ++size_;
+
+        if (node.expiry < wake_tick_) {
+            wake_tick_ = node.expiry;
+            notify = true;
+        }
+        handle = Handle{this, i, node.generation};
+    }
+    if (notify) { wake_.notify_one(); }
+    return handle;
+}
+
+inline auto TimerService::cancel(std::uint32_t index, std::uint32_t generation) -> bool
+{
+    auto const lock = std::lock_guard{mutex_};
+    auto& node = nodes_[index];
+    if (node.generation != generation) { return false; }
+    switch (node.state) {
+        case State::Pending:
+            unlink(index);
+            release_node(node, index);
+            return true;
+        case State::Firing:
+            // The thread frees it once the callback returns.
+            node.state = State::Cancelled;
+            return node.period != 0;
+        default:
+            return false;
+    }
+}
+
+}  // namespace zzz
@@ -1,8 +1,16 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <stop_token>
 #include <thread>
 #include <utility>
@@ -12,13 +20,67 @@ namespace zzz {
 /**
  * A thread of execution that waits for a given duration and then calls a callback fn.
  * @details This creates a new thread of execution on construction with the non-default
- * constructor.
+ * constructor. Between calls the thread blocks until the next deadline, or until it
+ * is asked to stop, so an idle timer doesn't wake up and a stop takes effect at once.
  */
 class TimerThread {
    public:
     using CallbackType = std::function<void()>;
     using ClockType = std::chrono::steady_clock;
 
+    /// What to do when a callback runs past the deadline of the next one.
+    enum class MissedTicks {
+        /// Call the callback back to back until it is on schedule again.
+        catch_up,
+        /// Drop the missed calls, the next one is at the next deadline still ahead.
+        /// The same as catch_up for a period of zero.
+        skip,
+        /// Schedule every call one period after the previous one returns, a fixed delay
+        /// rather than a fixed rate.
+        delay,
+    };
+
+    /// Tuning of a TimerThread.
+    struct Options {
+        /// What to do when a callback runs past the deadline of the next one.
+        MissedTicks missed_ticks{MissedTicks::catch_up};
+
+        /**
+         * How long before each deadline to stop sleeping and spin instead.
+         * @details Waking up from a sleep takes from tens of microseconds to a
+         * scheduler tick. Spinning through the end of the wait trades that much CPU
+         * time per period for precise deadlines, e.g. for sub-millisecond periods.
+         */
+        ClockType::duration spin{0};
+    };
+
+    /// Number of buckets of Stats::lateness_histogram.
+    static constexpr std::size_t lateness_buckets = 24;
+
+    /**
+     * Statistics of the calls of a TimerThread's callback.
+     * @details Lateness is how long after its deadline a call starts. The histogram
+     * counts the calls by lateness in microseconds, bucket 0 those less than 1us late
+     * and bucket i those less than 2^i us, the last bucket also counts all the later
+     * ones.
+     */
+    struct Stats {
+        /// Return the mean lateness, zero if there were no calls.
+        [[nodiscard]] auto average_lateness() const noexcept -> ClockType::duration
+        {
+            if (calls == 0) { return ClockType::duration{0}; }
+            return total_lateness / static_cast<ClockType::rep>(calls);
+        }
+
+        std::uint64_t calls{0};
+        /// Calls that returned after the deadline of the next call.
+        std::uint64_t overruns{0};
+        ClockType::duration min_lateness{0};
+        ClockType::duration max_lateness{0};
+        ClockType::duration total_lateness{0};
+        std::array<std::uint64_t, lateness_buckets> lateness_histogram{};
+    };
+
    public:
     /**
      * Create a placeholder TimerThread that does nothing.
@@ -32,10 +94,23 @@ class TimerThread {
      * @param duration The periodic duration to wait before calling the callback
      * @param callback The function to call each time the duration has elapsed
      */
-    explicit TimerThread(std::chrono::milliseconds duration, CallbackType callback)
-        : thread_{[cb = std::move(callback), d = std::move(duration)](auto st) {
-              TimerThread::run(st, cb, d);
-          }}
+    explicit TimerThread(ClockType::duration duration, CallbackType callback)
+        : TimerThread(duration, std::move(callback), Options{})
+    {}
+
+    /**
+     * Create a TimerThread that will call the callback after the duration in a loop.
+     * @details This will launch a thread immediately.
+     * @param duration The periodic duration to wait before calling the callback
+     * @param callback The function to call each time the duration has elapsed
+     * @param options How to wait for each deadline
+     */
+    explicit TimerThread(ClockType::duration duration,
+                         CallbackType callback,
+                         Options options)
+        : counters_{std::make_shared<Counters>()},
+          thread_{[cb = std::move(callback), d = duration, options, c = counters_](
+                      auto st) { TimerThread::run(st, cb, d, options, *c); }}
     {}
 
     TimerThread(TimerThread const&) = delete;
@@ -52,36 +127,147 @@ class TimerThread {
      */
     void request_stop() { thread_.request_stop(); }
 
+    /**
+     * Return the statistics of the calls so far.
+     * @details This doesn't lock or wait for the thread, it reads each figure as it
+     * is at the time, so while the thread runs they may be a call apart.
+     */
+    [[nodiscard]] auto stats() const noexcept -> Stats
+    {
+        return counters_ ? counters_->load() : Stats{};
+    }
+
    private:
+    /// Stats as the thread updates them; only the thread writes to them.
+    struct Counters {
+        void record(ClockType::duration lateness, bool overrun) noexcept
+        {
+            auto const count = lateness.count();
+            if (calls.load(std::memory_order_relaxed) == 0 ||
+                count < min_lateness.load(std::memory_order_relaxed)) {
+                min_lateness.store(count, std::memory_order_relaxed);
+            }
+            if (count > max_lateness.load(std::memory_order_relaxed)) {
+                max_lateness.store(count, std::memory_order_relaxed);
+            }
+            increment(total_lateness, count);
+
+            auto const us = static_cast<std::uint64_t>(std::max<ClockType::rep>(
+                std::chrono::duration_cast<std::chrono::microseconds>(lateness).count(),
+                0));
+            auto const bucket =
+                std::min<std::size_t>(std::bit_width(us), lateness_buckets - 1);
+            increment(lateness_histogram[bucket], std::uint64_t{1});
+
+            if (overrun) { increment(overruns, std::uint64_t{1}); }
+            increment(calls, std::uint64_t{1});
+        }
+
+        [[nodiscard]] auto load() const noexcept -> Stats
+        {
+            auto stats = Stats{};
+            stats.calls = calls.load(std::memory_order_relaxed);
+            stats.overruns = overruns.load(std::memory_order_relaxed);
+            stats.min_lateness = load_duration(min_lateness);
+            stats.max_lateness = load_duration(max_lateness);
+            stats.total_lateness = load_duration(total_lateness);
+            for (auto i = std::size_t{0}; i < lateness_buckets; ++i) {
+                stats.lateness_histogram[i] =
+                    lateness_histogram[i].load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+
+        static auto load_duration(std::atomic<ClockType::rep> const& counter) noexcept
+            -> ClockType::duration
+        {
+            return ClockType::duration{counter.load(std::memory_order_relaxed)};
+        }
+
+        /// A load and a store, rather than a read-modify-write, as nothing else
+        /// writes to \p counter.
+        template <typename T>
+        static void increment(std::atomic<T>& counter, T value) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value,
+                          std::memory_order_relaxed);
+        }
+
+        std::atomic<std::uint64_t> calls{0};
+        std::atomic<std::uint64_t> overruns{0};
+        std::atomic<ClockType::rep> min_lateness{0};
+        std::atomic<ClockType::rep> max_lateness{0};
+        std::atomic<ClockType::rep> total_lateness{0};
+        std::array<std::atomic<std::uint64_t>, lateness_buckets> lateness_histogram{};
+    };
+
     /**
      * Run the TimerThread, calling the callback after the given duration and repeating
      * until st.stop_requested() is true.
      * @param st The stop_token to check for stop_requested().
      * @param callback The function to call each time the duration has elapsed
      * @param duration The periodic duration to wait before calling the callback
+     * @param options How to wait for each deadline
+     * @param counters The statistics to update after each call
      */
     static void run(std::stop_token st,
                     CallbackType const& callback,
-                    std::chrono::milliseconds duration)
+                    ClockType::duration duration,
+                    Options const& options,
+                    Counters& counters)
     {
-        constexpr auto max_sleep = std::chrono::duration_cast<ClockType::duration>(
-            std::chrono::milliseconds{16});
-
         auto next_time = ClockType::now() + duration;
-        while (!st.stop_requested()) {
-            auto const now = ClockType::now();
+        while (wait_until(st, next_time, options)) {
+            auto const start = ClockType::now();
+            callback();
+            auto const end = ClockType::now();
+
+            auto const deadline = next_time;
+            next_time += duration;
+            counters.record(start - deadline, end > next_time);
 
-            if (now >= next_time) {
-                callback();
-                next_time += duration;
+            switch (options.missed_ticks) {
+                case MissedTicks::catch_up:
+                    break;
+                case MissedTicks::skip:
+                    // A period of zero or less calls continuously, nothing to skip.
+                    if (duration > ClockType::duration::zero() && end > next_time) {
+                        next_time += (end - next_time) / duration * duration + duration;
+                    }
+                    break;
+                case MissedTicks::delay:
+                    next_time = end + duration;
+                    break;
             }
+        }
+    }
+
+    /**
+     * Block until \p deadline, sleeping on an absolute deadline and then spinning for
+     * the last options.spin of it.
+     * @return False if a stop was requested before the deadline, true otherwise
+     */
+    static auto wait_until(std::stop_token const& st,
+                           ClockType::time_point deadline,
+                           Options const& options) -> bool
+    {
+        // Nothing notifies the condition variable but a stop request, it only
+        // provides a sleep that a stop request interrupts.
+        auto mutex = std::mutex{};
+        auto wakeup = std::condition_variable_any{};
+        auto lock = std::unique_lock{mutex};
+        wakeup.wait_until(lock, st, deadline - options.spin, [] { return false; });
 
-            auto const sleep_duration = std::min(next_time - now, max_sleep);
-            std::this_thread::sleep_for(sleep_duration);
+        while (!st.stop_requested() && ClockType::now() < deadline) {
+            std::this_thread::yield();
         }
+        return !st.stop_requested();
     }
 
    private:
+    // Shared with the thread, which may outlive a moved-from or reassigned owner
+    // until it is joined.
+    std::shared_ptr<Counters> counters_;
     std::jthread thread_;
 };
 
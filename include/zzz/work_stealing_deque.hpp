@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace zzz {
+
+/**
+ * @brief Chase-Lev work stealing deque of trivially copyable values, e.g. pointers.
+ * @details One owner thread pushes and pops at the bottom, LIFO, while any number of
+ * other threads steal from the top, FIFO. Push and pop only touch shared state to
+ * settle a race for the last element; steal costs one compare and swap. The ring
+ * buffer grows as needed; buffers it outgrows are kept until the deque is destroyed,
+ * since a concurrent steal may still read them. Memory orders follow Lê et al.,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+ */
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class WorkStealingDeque {
+   public:
+    using value_type = T;
+
+   public:
+    /// Create an empty deque with room for \p capacity values, rounded up to a power
+    /// of two, before it grows.
+    explicit WorkStealingDeque(std::size_t capacity = 1024)
+    {
+        auto const size = std::bit_ceil(std::max<std::size_t>(capacity, 2));
+        auto buffer = std::make_unique<Buffer>(size);
+        buffer_.store(buffer.get(), std::memory_order_relaxed);
+        buffers_.push_back(std::move(buffer));
+    }
+
+    WorkStealingDeque(WorkStealingDeque const&) = delete;
+    auto operator=(WorkStealingDeque const&) -> WorkStealingDeque& = delete;
+
+   public:
+    /// Push \p x at the bottom, owner thread only.
+    void push(T x)
+    {
+        auto const bottom = bottom_.load(std::memory_order_relaxed);
+        auto const top = top_.load(std::memory_order_acquire);
+        auto buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > static_cast<std::int64_t>(buffer->mask)) {
+            buffer = grow(buffer, top, bottom);
+        }
+        buffer->put(bottom, x);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /// Pop the value pushed last, owner thread only; std::nullopt if empty.
+    [[nodiscard]] auto pop() -> std::optional<T>
+    {
+        auto const bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        auto const buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = top_.load(std::memory_order_relaxed);
+
+        auto result = std::optional<T>{};
+        if (top <= bottom) {
+            result = buffer->get(bottom);
+            if (top == bottom) {
+                // Last value, race the thieves for it.
+                if (!top_.compare_exchange_strong(top, top + 1,
+                                                  std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+                    result = std::nullopt;
+                }
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+        }
+        else {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    /// Steal the oldest value, from any thread; std::nullopt if empty or if another
+    /// thread took it first.
+    [[nodiscard]] auto steal() -> std::optional<T>
+    {
+        auto top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto const bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) { return std::nullopt; }
+
+        auto const x = buffer_.load(std::memory_order_acquire)->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return x;
+    }
+
+    /// Return the number of values, only a hint while other threads use the deque.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        auto const bottom = bottom_.load(std::memory_order_relaxed);
+        auto const top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    /// Return true if there are no values, only a hint while other threads use it.
+    [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+    /// Return the number of values the deque holds before it grows.
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t
+    {
+        return buffer_.load(std::memory_order_relaxed)->mask + 1;
+    }
+
+   private:
+    struct Buffer {
+        explicit Buffer(std::size_t capacity)
+            : mask{capacity - 1}, values{std::make_unique<std::atomic<T>[]>(capacity)}
+        {}
+
+        [[nodiscard]] auto get(std::int64_t i) const noexcept -> T
+        {
+            auto const& slot = values[static_cast<std::size_t>(i) & mask];
+            return slot.load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t i, T x) noexcept
+        {
+            auto& slot = values[static_cast<std::size_t>(i) & mask];
+            slot.store(x, std::memory_order_relaxed);
+        }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> values;
+    };
+
+    /// Copy the values of \p buffer to a buffer twice its size and publish it.
+    auto grow(Buffer* buffer, std::int64_t top, std::int64_t bottom) -> Buffer*
+    {
+        auto bigger = std::make_unique<Buffer>(2 * (buffer->mask + 1));
+        for (auto i = top; i != bottom; ++i) {
+            bigger->put(i, buffer->get(i));
+        }
+        auto const result = bigger.get();
+        buffers_.push_back(std::move(bigger));
+        buffer_.store(result, std::memory_order_release);
+        return result;
+    }
+
+   private:
+    // Thieves write top, the owner writes bottom, keep them on separate cache lines.
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_{nullptr};
+
+    /// Every buffer used so far, only touched by the owner.
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+}  // namespace zzz
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "./work_stealing_deque.hpp"
+
+namespace zzz {
+namespace detail {
+
+/// Pin the calling thread to the \p index th CPU it may run on, modulo their count.
+/** Best effort, does nothing where it isn't supported or allowed. */
+inline void pin_to_cpu(std::size_t index) noexcept
+{
+#if defined(__linux__)
+    auto allowed = cpu_set_t{};
+    CPU_ZERO(&allowed);
+    if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0) { return; }
+    auto const count = static_cast<std::size_t>(CPU_COUNT(&allowed));
+    if (count == 0) { return; }
+
+    auto target = index % count;
+    for (auto cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed) || target-- != 0) { continue; }
+        auto set = cpu_set_t{};
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+        return;
+    }
+#else
+    (void)index;
+#endif
+}
+
+/**
+ * @brief Worker threads that run work items of type \p T by calling
+ * `Execute{}(item)`, the core of Scheduler and ThreadPool.
+ * @details \p T is a handle such as a pointer, a value-initialized T is never pushed.
+ * Each worker has a WorkStealingDeque of items. An item pushed from a worker goes to
+ * that worker's deque, which the worker runs LIFO, while idle workers steal the
+ * oldest entries of the others. Items pushed from other threads go through a shared,
+ * locked queue. Workers with nothing to do spin briefly, then sleep until new work
+ * is pushed.
+ *
+ * The destructor waits for the workers to run every pushed item, including those
+ * pushed meanwhile, and then joins them.
+ */
+template <typename T, typename Execute>
+    requires std::is_nothrow_invocable_v<Execute const&, T>
+class WorkStealingExecutor {
+   public:
+    /// Start \p thread_count workers, at least one; one per hardware thread if zero.
+    /** With \p pin_threads the i-th worker is pinned with pin_to_cpu(i). */
+    explicit WorkStealingExecutor(std::size_t thread_count, bool pin_threads = false)
+    {
+        if (thread_count == 0) {
+            thread_count = std::thread::hardware_concurrency();
+        }
+        thread_count = std::max<std::size_t>(thread_count, 1);
+        workers_.reserve(thread_count);
+        for (auto i = std::size_t{0}; i < thread_count; ++i) {
+            workers_.push_back(std::make_unique<Worker>(*this, i));
+        }
+        threads_.reserve(thread_count);
+        for (auto i = std::size_t{0}; i < thread_count; ++i) {
+            threads_.emplace_back([this, i, pin_threads] {
+                if (pin_threads) { pin_to_cpu(i); }
+                run(*workers_[i]);
+            });
+        }
+    }
+
+    WorkStealingExecutor(WorkStealingExecutor const&) = delete;
+    auto operator=(WorkStealingExecutor const&) -> WorkStealingExecutor& = delete;
+
+    ~WorkStealingExecutor()
+    {
+        stop_.store(true);
+        wake(true);
+        threads_.clear();
+    }
+
+   public:
+    /// Have a worker run \p item.
+    void push(T item)
+    {
+        if (auto const worker = current_worker; worker && &worker->executor == this) {
+            worker->deque.push(item);
+        }
+        else {
+            auto const lock = std::lock_guard{injected_mutex_};
+            injected_.push_back(item);
+            injected_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed) != 0) { wake(false); }
+    }
+
+    /// Return true if the calling thread is one of the workers.
+    [[nodiscard]] auto is_worker() const noexcept -> bool
+    {
+        auto const worker = current_worker;
+        return worker && &worker->executor == this;
+    }
+
+    /// Run an item that is ready, if any, on the calling thread, which must be one of
+    /// the workers; return false if none was.
+    auto run_one() -> bool
+    {
+        auto const item = find_work(*current_worker);
+        if (!item) { return false; }
+        Execute{}(item);
+        return true;
+    }
+
+    /// Return the number of worker threads.
+    [[nodiscard]] auto thread_count() const noexcept -> std::size_t
+    {
+        return workers_.size();
+    }
+
+   private:
+    struct Worker {
+        Worker(WorkStealingExecutor& executor, std::size_t index)
+            : executor{executor}, index{index}
+        {}
+
+        WorkStealingExecutor& executor;
+        std::size_t index;
+        WorkStealingDeque<T> deque;
+    };
+
+    /// Idle rounds over every queue a worker makes before it goes to sleep.
+    static constexpr int spin_rounds = 64;
+
+    /// Worker the calling thread is, of any executor of this type; nullptr if none.
+    static inline thread_local Worker* current_worker = nullptr;
+
+    void run(Worker& worker)
+    {
+        current_worker = &worker;
+        while (true) {
+            if (auto const item = find_work(worker)) {
+                Execute{}(item);
+                continue;
+            }
+            if (!idle(worker)) { break; }
+        }
+        current_worker = nullptr;
+    }
+
+    /// Wait for work, return false once the executor stops and no work is left.
+    auto idle(Worker& worker) -> bool
+    {
+        for (auto i = 0; i < spin_rounds; ++i) {
+            if (has_work(worker)) { return true; }
+            std::this_thread::yield();
+        }
+
+        // Announce the sleep before the last look, so that push either sees a sleeper
+        // to wake or its work is seen here.
+        sleeping_.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto const epoch = epoch_.load();
+        auto const stop = stop_.load();
+        auto const ready = has_work(worker);
+        if (!ready && !stop) { epoch_.wait(epoch); }
+        sleeping_.fetch_sub(1);
+        return ready || !stop || has_work(worker);
+    }
+
+    void wake(bool all)
+    {
+        epoch_.fetch_add(1);
+        if (all)
+            epoch_.notify_all();
+        else
+            epoch_.notify_one();
+    }
+
+    /// Pop from \p worker's deque, else take from the shared queue, else steal.
+    auto find_work(Worker& worker) -> T
+    {
+        if (auto const item = worker.deque.pop()) { return *item; }
+        if (injected_count_.load(std::memory_order_relaxed) != 0) {
+            auto const lock = std::lock_guard{injected_mutex_};
+            if (!injected_.empty()) {
+                auto const item = injected_.front();
+                injected_.pop_front();
+                injected_count_.fetch_sub(1, std::memory_order_relaxed);
+                return item;
+            }
+        }
+        auto const count = workers_.size();
+        for (auto i = std::size_t{1}; i < count; ++i) {
+            auto& victim = *workers_[(worker.index + i) % count];
+            if (auto const item = victim.deque.steal()) { return *item; }
+        }
+        return T{};
+    }
+
+    [[nodiscard]] auto has_work(Worker const& worker) const -> bool
+    {
+        if (!worker.deque.empty() || injected_count_.load() != 0) { return true; }
+        return std::ranges::any_of(
+            workers_, [](auto const& other) { return !other->deque.empty(); });
+    }
+
+   private:
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex injected_mutex_;
+    std::deque<T> injected_;
+    std::atomic<std::size_t> injected_count_{0};
+
+    std::atomic<std::size_t> sleeping_{0};
+    std::atomic<std::uint64_t> epoch_{0};
+    std::atomic<bool> stop_{false};
+
+    // Declared last, so the workers are joined before the state they use is gone.
+    std::vector<std::jthread> threads_;
+};
+
+}  // namespace detail
+}  // namespace zzz
@@ -0,0 +1,99 @@
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <zzz/adaptors.hpp>
+#include <zzz/container.hpp>
+#include <zzz/coro.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+auto naturals(int* resumes = nullptr) -> zzz::Generator<int>
+{
+    for (auto i = 0;; ++i) {
+        if (resumes) { ++*resumes; }
+        co_yield i;
+    }
+}
+
+auto range(int begin, int end) -> zzz::Generator<int>
+{
+    for (auto i = begin; i < end; ++i) {
+        co_yield i;
+    }
+}
+
+template <typename R>
+auto to_vector(R&& x)
+{
+    auto result = std::vector<std::ranges::range_value_t<R>>{};
+    for (auto&& element : x) {
+        result.push_back(element);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(adaptors)
+{
+    auto const squares = range(0, 5) | zzz::map([](int x) { return x * x; });
+    static_assert(std::ranges::input_range<decltype(squares)>);
+    ASSERT((to_vector(squares) == std::vector<int>{0, 1, 4, 9, 16}));
+
+    auto const evens = zzz::filter(range(0, 10), [](int x) { return x % 2 == 0; });
+    ASSERT((to_vector(evens) == std::vector<int>{0, 2, 4, 6, 8}));
+
+    // Doesn't resume the endless generator past the last element taken.
+    auto resumes = 0;
+    ASSERT((to_vector(naturals(&resumes) | zzz::take(3)) == std::vector<int>{0, 1, 2}));
+    ASSERT(resumes == 3);
+    ASSERT(to_vector(range(0, 2) | zzz::take(5)).size() == 2);
+    ASSERT(to_vector(range(0, 2) | zzz::take(0)).empty());
+
+    auto chunks = std::vector<std::vector<int>>{};
+    for (auto chunk : range(0, 7) | zzz::chunk(3)) {
+        chunks.emplace_back(chunk.begin(), chunk.end());
+    }
+    ASSERT((chunks == std::vector<std::vector<int>>{{0, 1, 2}, {3, 4, 5}, {6}}));
+    ASSERT(to_vector(range(0, 0) | zzz::chunk(3)).empty());
+
+    auto const names = std::vector<std::string>{"foo", "bar", "baz"};
+    auto zipped = std::vector<std::pair<int, std::string>>{};
+    for (auto [i, name] : naturals() | zzz::zip(names)) {
+        zipped.emplace_back(i, name);
+    }
+    using Zipped = std::vector<std::pair<int, std::string>>;
+    ASSERT((zipped == Zipped{{0, "foo"}, {1, "bar"}, {2, "baz"}}));
+    ASSERT(to_vector(zzz::zip(names, range(0, 1))).size() == 1);
+
+    auto x = std::vector<int>{5, 6, 7};
+    for (auto [i, value] : x | zzz::enumerate()) {
+        value += static_cast<int>(i);  // Lvalue ranges are referenced, not copied.
+    }
+    ASSERT((x == std::vector<int>{5, 7, 9}));
+}
+
+TEST(adaptors_compose)
+{
+    // Sum of the squares of the first five odd numbers.
+    auto const sum = naturals() | zzz::filter([](int x) { return x % 2 != 0; }) |
+                     zzz::map([](int x) { return x * x; }) | zzz::take(5) |
+                     zzz::reduce([](int a, int b) { return a + b; }, 0);
+    ASSERT(sum == 1 + 9 + 25 + 49 + 81);
+
+    auto const labels = range(0, 4) | zzz::enumerate() | zzz::map([](auto x) {
+                            return std::to_string(x.first * x.second);
+                        });
+    ASSERT((to_vector(labels) == std::vector<std::string>{"0", "1", "4", "9"}));
+
+    auto const total = range(0, 10) | zzz::chunk(4) |
+                       zzz::map([](std::span<int const> x) { return x.size(); }) |
+                       zzz::reduce([](std::size_t a, std::size_t b) { return a + b; },
+                                   std::size_t{0});
+    ASSERT(total == 10);
+}
@@ -0,0 +1,74 @@
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <zzz/async_generator.hpp>
+#include <zzz/scheduler.hpp>
+#include <zzz/task.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+auto ticks(zzz::Scheduler& scheduler, int count) -> zzz::AsyncGenerator<int>
+{
+    for (auto i = 0; i < count; ++i) {
+        co_await scheduler.schedule();  // As if waiting on I/O.
+        co_yield i;
+    }
+}
+
+/// Yield 0 to 9, in batches and one by one.
+auto mixed() -> zzz::AsyncGenerator<int>
+{
+    auto batch = std::array<int, 4>{0, 1, 2, 3};
+    co_yield std::span{batch};
+    co_yield std::span<int>{};  // Skipped.
+    co_yield 4;
+    auto rest = std::vector<int>{5, 6, 7, 8, 9};
+    co_yield zzz::elements_of(rest);
+}
+
+auto fail_after(int count) -> zzz::AsyncGenerator<int>
+{
+    for (auto i = 0; i < count; ++i) {
+        co_yield i;
+    }
+    throw std::runtime_error{"producer"};
+}
+
+auto collect(zzz::AsyncGenerator<int> gen) -> zzz::Task<std::vector<int>>
+{
+    auto result = std::vector<int>{};
+    for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it) {
+        result.push_back(*it);
+    }
+    co_return result;
+}
+
+auto batch_sizes(zzz::AsyncGenerator<int> gen) -> zzz::Task<std::vector<std::size_t>>
+{
+    auto result = std::vector<std::size_t>{};
+    for (auto batch = co_await gen.next(); !batch.empty();
+         batch = co_await gen.next()) {
+        result.push_back(batch.size());
+    }
+    co_return result;
+}
+
+}  // namespace
+
+TEST(async_generator)
+{
+    auto const expected = std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ASSERT(zzz::sync_wait(collect(mixed())) == expected);
+    ASSERT((zzz::sync_wait(batch_sizes(mixed())) == std::vector<std::size_t>{4, 1, 5}));
+
+    auto scheduler = zzz::Scheduler{2};
+    ASSERT(zzz::sync_wait(collect(ticks(scheduler, 10))) == expected);
+    ASSERT(zzz::sync_wait(collect(ticks(scheduler, 0))).empty());
+
+    ASSERT_THROWS(zzz::sync_wait(collect(fail_after(3))), std::runtime_error);
+    ASSERT_THROWS(zzz::sync_wait(batch_sizes(fail_after(0))), std::runtime_error);
+}
@@ -0,0 +1,191 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zzz/bounded_queue.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+/// Push \p count consecutive values, from \p first on, one at a time or in batches.
+template <typename Queue>
+void produce(Queue& queue, int first, int count, bool batch)
+{
+    auto values = std::array<int, 16>{};
+    for (auto i = first; i < first + count;) {
+        if (!batch) {
+            if (queue.try_push(i)) {
+                ++i;
+            }
+            else {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        auto const size = std::min<std::size_t>(values.size(), first + count - i);
+        for (auto j = std::size_t{0}; j < size; ++j) {
+            values[j] = i + static_cast<int>(j);
+        }
+        auto const pushed = queue.try_push_batch(std::span{values.data(), size});
+        i += static_cast<int>(pushed);
+        if (pushed == 0) { std::this_thread::yield(); }
+    }
+}
+
+}  // namespace
+
+TEST(spsc_queue)
+{
+    auto queue = zzz::SpscQueue<std::string>{3};
+    ASSERT(queue.capacity() == 4);
+    ASSERT(queue.empty());
+    ASSERT(!queue.try_pop());
+
+    ASSERT(queue.try_push("a"));
+    ASSERT(queue.try_emplace(2, 'b'));
+    auto const c = std::string{"c"};
+    ASSERT(queue.try_push(c));
+    ASSERT(queue.try_push("d"));
+    ASSERT(queue.size() == 4);
+    auto e = std::string{"e"};
+    ASSERT(!queue.try_push(std::move(e)));
+    ASSERT(e == "e");
+
+    ASSERT(queue.try_pop() == "a");
+    ASSERT(queue.try_pop() == "bb");
+    ASSERT(queue.try_push(std::move(e)));
+
+    auto out = std::array<std::string, 8>{};
+    ASSERT(queue.try_pop_batch(out) == 3);
+    ASSERT(out[0] == "c" && out[1] == "d" && out[2] == "e");
+    ASSERT(queue.empty());
+
+    auto in = std::array<std::string, 6>{"0", "1", "2", "3", "4", "5"};
+    ASSERT(queue.try_push_batch(in) == 4);
+    ASSERT(in[4] == "4" && in[5] == "5");
+    ASSERT(queue.try_pop_batch(std::span{out.data(), 1}) == 1 && out[0] == "0");
+    ASSERT(queue.try_push_batch(std::span{in}.subspan(4)) == 1);
+    ASSERT(queue.try_pop_batch(out) == 4);
+    ASSERT(out[0] == "1" && out[3] == "4");
+}
+
+TEST(spsc_queue_move_only)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        auto queue = zzz::SpscQueue<std::unique_ptr<std::shared_ptr<int>>>{4};
+        ASSERT(queue.try_push(std::make_unique<std::shared_ptr<int>>(counter)));
+        ASSERT(queue.try_emplace(new std::shared_ptr<int>{counter}));
+        ASSERT(counter.use_count() == 3);
+        ASSERT(queue.try_pop().value() != nullptr);
+        ASSERT(counter.use_count() == 2);
+    }
+    // The queue destroys the values left in it.
+    ASSERT(counter.use_count() == 1);
+}
+
+TEST(spsc_queue_concurrent)
+{
+    for (auto batch : {false, true}) {
+        constexpr auto count = 100'000;
+        auto queue = zzz::SpscQueue<int>{64};
+        auto producer = std::jthread{[&] { produce(queue, 0, count, batch); }};
+
+        auto in_order = true;
+        auto out = std::array<int, 16>{};
+        for (auto next = 0; next < count;) {
+            auto popped = std::size_t{0};
+            if (batch) {
+                popped = queue.try_pop_batch(out);
+            }
+            else if (auto const x = queue.try_pop()) {
+                out[0] = *x;
+                popped = 1;
+            }
+            if (popped == 0) { std::this_thread::yield(); }
+            for (auto i = std::size_t{0}; i < popped; ++i) {
+                in_order = in_order && out[i] == next + static_cast<int>(i);
+            }
+            next += static_cast<int>(popped);
+        }
+        ASSERT(in_order);
+    }
+}
+
+TEST(mpmc_queue)
+{
+    auto queue = zzz::MpmcQueue<std::unique_ptr<int>>{3};
+    ASSERT(queue.capacity() == 4);
+    ASSERT(!queue.try_pop());
+
+    for (auto i = 0; i < 4; ++i) {
+        ASSERT(queue.try_push(std::make_unique<int>(i)));
+    }
+    auto extra = std::make_unique<int>(4);
+    ASSERT(!queue.try_push(std::move(extra)));
+    ASSERT(extra != nullptr);
+    ASSERT(queue.size() == 4);
+
+    ASSERT(*queue.try_pop().value() == 0);
+    auto out = std::array<std::unique_ptr<int>, 2>{};
+    ASSERT(queue.try_pop_batch(out) == 2);
+    ASSERT(*out[0] == 1 && *out[1] == 2);
+
+    auto in = std::array<std::unique_ptr<int>, 4>{};
+    for (auto i = 0; i < 4; ++i) {
+        in[static_cast<std::size_t>(i)] = std::make_unique<int>(10 + i);
+    }
+    ASSERT(queue.try_push_batch(in) == 3);
+    ASSERT(in[2] == nullptr && in[3] != nullptr);
+    ASSERT(queue.try_emplace(nullptr) == false);
+
+    auto rest = std::array<std::unique_ptr<int>, 8>{};
+    ASSERT(queue.try_pop_batch(rest) == 4);
+    ASSERT(*rest[0] == 3 && *rest[1] == 10 && *rest[3] == 12);
+    ASSERT(queue.empty());
+}
+
+TEST(mpmc_queue_concurrent)
+{
+    constexpr auto threads = 3;
+    constexpr auto count = 30'000;
+    for (auto batch : {false, true}) {
+        auto queue = zzz::MpmcQueue<int>{64};
+        auto sum = std::atomic<long>{0};
+        auto popped = std::atomic<int>{0};
+        {
+            auto workers = std::vector<std::jthread>{};
+            for (auto t = 0; t < threads; ++t) {
+                workers.emplace_back(
+                    [&, t] { produce(queue, t * count, count, batch); });
+                workers.emplace_back([&] {
+                    auto out = std::array<int, 16>{};
+                    while (popped.load() < threads * count) {
+                        auto n = std::size_t{0};
+                        if (batch) {
+                            n = queue.try_pop_batch(out);
+                        }
+                        else if (auto const x = queue.try_pop()) {
+                            out[0] = *x;
+                            n = 1;
+                        }
+                        if (n == 0) { std::this_thread::yield(); }
+                        for (auto i = std::size_t{0}; i < n; ++i) {
+                            sum += out[i];
+                        }
+                        popped += static_cast<int>(n);
+                    }
+                });
+            }
+        }
+        auto const total = threads * count;
+        ASSERT(popped.load() == total);
+        ASSERT(sum.load() == static_cast<long>(total) * (total - 1) / 2);
+    }
+}
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <zzz/char_traits.hpp>
+#include <zzz/test.hpp>
+
+static_assert(zzz::is_whitespace('\n'));
+static_assert(!zzz::is_whitespace('x'));
+static_assert(zzz::is_hexidecimal_digit('F'));
+static_assert(noexcept(zzz::is_digit('0')));
+
+TEST(char_traits_match_cctype)
+{
+    // Outside of ASCII the "C" locale classifies nothing, as the table does.
+    for (auto i = 0; i < 256; ++i) {
+        auto const c = static_cast<char>(i);
+        ASSERT(zzz::is_whitespace(c) == (std::isspace(i) != 0));
+        ASSERT(zzz::is_alphabetic(c) == (std::isalpha(i) != 0));
+        ASSERT(zzz::is_digit(c) == (std::isdigit(i) != 0));
+        ASSERT(zzz::is_hexidecimal_digit(c) == (std::isxdigit(i) != 0));
+        ASSERT(zzz::is_control(c) == (std::iscntrl(i) != 0));
+        ASSERT(zzz::is_graphical(c) == (std::isgraph(i) != 0));
+        ASSERT(zzz::is_blank(c) == (std::isblank(i) != 0));
+        ASSERT(zzz::is_alphanumeric(c) == (std::isalnum(i) != 0));
+        ASSERT(zzz::is_lowercase(c) == (std::islower(i) != 0));
+        ASSERT(zzz::is_uppercase(c) == (std::isupper(i) != 0));
+        ASSERT(zzz::is_punctuation(c) == (std::ispunct(i) != 0));
+        ASSERT(zzz::is_printable(c) == (std::isprint(i) != 0));
+    }
+}
+
+TEST(char_traits_bulk)
+{
+    {
+        auto const x = std::string_view{"  \t\n foo bar"};
+        ASSERT(*zzz::find_first_not_whitespace(x) == 'f');
+        ASSERT(zzz::find_first_whitespace(x) == x.begin());
+        ASSERT(zzz::find_first_not_whitespace("   ") == std::string_view{"   "}.end());
+        ASSERT(zzz::count_digits("a1b22c333") == 6);
+        ASSERT(zzz::count_digits("") == 0);
+    }
+    {  // Differential against the scalar predicates.
+        auto gen = std::mt19937{5};
+        auto const alphabet = std::string_view{" \t\n\v\f\r09az!\x80\xff"};
+        for (auto size = std::size_t{0}; size < 200; ++size) {
+            auto x = std::string(size, '\0');
+            for (auto& c : x) {
+                c = alphabet[gen() % alphabet.size()];
+            }
+            auto const view = std::string_view{x};
+            ASSERT(zzz::find_first_whitespace(view) ==
+                   std::find_if(view.begin(), view.end(), zzz::is_whitespace));
+            ASSERT(zzz::find_first_not_whitespace(view) ==
+                   std::find_if_not(view.begin(), view.end(), zzz::is_whitespace));
+            ASSERT(zzz::count_digits(view) ==
+                   static_cast<std::size_t>(
+                       std::count_if(view.begin(), view.end(), zzz::is_digit)));
+
+            // Long whitespace runs, the search must cross vector blocks.
+            auto const padded = std::string(size, ' ') + x;
+            auto const padded_view = std::string_view{padded};
+            ASSERT(zzz::find_first_not_whitespace(padded_view) ==
+                   std::find_if_not(padded_view.begin(), padded_view.end(),
+                                    zzz::is_whitespace));
+        }
+    }
+}
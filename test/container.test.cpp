@@ -1,11 +1,20 @@
 #include <array>
+#include <cstdint>
+#include <deque>
+#include <forward_list>
+#include <list>
 #include <functional>
 #include <map>
+#include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include <zzz/container.hpp>
+#include <zzz/flat_map.hpp>
 #include <zzz/test.hpp>
 
 TEST(head_tail)
@@ -32,6 +41,30 @@ TEST(head_tail)
     }
 }
 
+TEST(head_tail_ranges)
+{
+    {
+        auto const storage = std::vector<int>{1, 2, 3, 4, 5};
+        auto const x = std::span{storage}.subspan(1, 3);
+        ASSERT(*zzz::head(x) == 2);
+        ASSERT(*zzz::tail(x) == 4);
+        ASSERT(zzz::head_ptr(x) == &storage[1]);
+        ASSERT(zzz::tail_ptr(x) == &storage[3]);
+    }
+    {
+        auto const x = std::deque<std::string>{"foo", "bar"};
+        ASSERT(*zzz::head(x) == "foo");
+        ASSERT(*zzz::tail_ptr(x) == "bar");
+        ASSERT(zzz::head_ptr(std::deque<int>{}) == nullptr);
+    }
+    {
+        auto const x = std::forward_list<int>{7, 8};
+        ASSERT(*zzz::head(x) == 7);
+        ASSERT(*zzz::head(std::views::iota(3, 6)) == 3);
+        ASSERT(*zzz::tail(std::views::iota(3, 6)) == 5);
+    }
+}
+
 TEST(lookup)
 {
     {
@@ -53,6 +86,89 @@ TEST(lookup)
     }
 }
 
+namespace {
+
+/// Hash for heterogeneous lookup of std::string keys.
+struct StringHash {
+    using is_transparent = void;
+    auto operator()(std::string_view x) const -> std::size_t
+    {
+        return std::hash<std::string_view>{}(x);
+    }
+};
+
+}  // namespace
+
+TEST(lookup_heterogeneous)
+{
+    {  // Transparent maps look up string_views without building a std::string.
+        auto x = std::unordered_map<std::string, int, StringHash, std::equal_to<>>{
+            {"foo", 1}, {"bar", 2}};
+        ASSERT(*zzz::lookup(x, std::string_view{"foo"}) == 1);
+        ASSERT(!zzz::lookup(x, std::string_view{"baz"}).has_value());
+
+        auto const value = zzz::lookup_ptr(x, std::string_view{"bar"});
+        ASSERT(value != nullptr && *value == 2);
+        *value = 3;  // Non-const maps give mutable access.
+        ASSERT(x.at("bar") == 3);
+        ASSERT(zzz::lookup_ptr(x, std::string_view{"baz"}) == nullptr);
+    }
+    {
+        auto const x = std::map<std::string, std::string, std::less<>>{{"foo", "FOO"}};
+        auto const value = zzz::lookup_ptr(x, std::string_view{"foo"});
+        ASSERT(value == &x.at("foo"));
+        ASSERT(zzz::lookup_ptr(x, "bar") == nullptr);
+    }
+    {  // Not transparent, the key is converted.
+        auto const x = std::map<std::string, int>{{"foo", 1}};
+        ASSERT(*zzz::lookup(x, std::string_view{"foo"}) == 1);
+        ASSERT(*zzz::lookup_ptr(x, std::string_view{"foo"}) == 1);
+        ASSERT(*zzz::lookup(x, "foo") == 1);
+    }
+}
+
+TEST(lookup_batch)
+{
+    auto x = std::unordered_map<int, std::string>{};
+    auto y = std::map<int, std::string>{};
+    for (auto i = 0; i < 1'000; i += 2) {
+        x.emplace(i, std::to_string(i));
+        y.emplace(i, std::to_string(i));
+    }
+
+    auto keys = std::vector<int>{};
+    for (auto i = 0; i < 50; ++i) {
+        keys.push_back(i * 37 % 1'100);
+    }
+
+    auto out = std::vector<std::string const*>(keys.size());
+    zzz::lookup_batch(x, keys, out);
+    for (auto i = std::size_t{0}; i < keys.size(); ++i) {
+        ASSERT(out[i] == zzz::lookup_ptr(x, keys[i]));
+    }
+
+    zzz::lookup_batch(y, keys, out);
+    for (auto i = std::size_t{0}; i < keys.size(); ++i) {
+        ASSERT(out[i] == zzz::lookup_ptr(y, keys[i]));
+    }
+
+    // Hashed once and prefetched ahead.
+    auto z = zzz::FlatMap<int, std::string>{};
+    for (auto i = 0; i < 1'000; i += 2) {
+        z.try_emplace(i, std::to_string(i));
+    }
+    zzz::lookup_batch(z, keys, out);
+    for (auto i = std::size_t{0}; i < keys.size(); ++i) {
+        ASSERT(out[i] == zzz::lookup_ptr(z, keys[i]));
+        ASSERT(out[i] == nullptr || *out[i] == std::to_string(keys[i]));
+    }
+    zzz::lookup_batch(zzz::FlatMap<int, std::string>{}, keys, out);
+    ASSERT(out[0] == nullptr);
+
+    auto small = std::vector<std::string const*>(1);
+    ASSERT_THROWS(zzz::lookup_batch(x, keys, small), std::runtime_error);
+}
+
 TEST(contains)
 {
     {
@@ -70,6 +186,49 @@ TEST(contains)
     }
 }
 
+TEST(find_contains_ranges)
+{
+    {
+        auto const storage = std::vector<int>(100, 0);
+        auto const x = std::span{storage}.subspan(10, 50);
+        ASSERT(zzz::find(x, 0) == x.begin());
+        ASSERT(zzz::find(x, 1) == x.end());
+        ASSERT(!zzz::contains(x, 1));
+    }
+    {
+        auto const x = std::list<std::string>{"foo", "bar"};
+        ASSERT(zzz::find(x, "bar") == std::next(x.begin()));
+        ASSERT(zzz::contains(x, std::string_view{"foo"}));
+        ASSERT(!zzz::contains(x, "baz"));
+    }
+    {
+        auto const x = std::deque<double>{1.0, 2.0, 3.0};
+        ASSERT(zzz::contains(x, 2));
+        ASSERT((zzz::find_all(x, 3.0) == std::vector<std::uint64_t>{0b100}));
+    }
+}
+
+TEST(find_all)
+{
+    {
+        auto x = std::vector<int>(100, 0);
+        x[3] = x[64] = x[99] = 5;
+        auto const bits = zzz::find_all(x, 5);
+        ASSERT(bits.size() == 2);
+        ASSERT(bits[0] == std::uint64_t{1} << 3);
+        ASSERT(bits[1] == ((std::uint64_t{1} << 0) | (std::uint64_t{1} << 35)));
+        ASSERT(zzz::find(x, 5) - x.begin() == 3);
+    }
+    {
+        auto const x = std::vector<std::string>{"foo", "bar", "foo"};
+        auto const bits = zzz::find_all(x, std::string{"foo"});
+        ASSERT((bits == std::vector<std::uint64_t>{0b101}));
+    }
+    {
+        ASSERT(zzz::find_all(std::vector<double>{}, 1.0).empty());
+    }
+}
+
 TEST(reduce)
 {
     {
@@ -97,6 +256,13 @@ TEST(reduce)
         auto const r = zzz::reduce(std::multiplies{}, 1, x);
         ASSERT(r == 120);
     }
+    {
+        auto const x = std::deque<int>{1, 2, 3, 4, 5};
+        auto const y = std::vector<int>{1, 2, 3};
+        ASSERT(zzz::reduce(std::plus{}, 0, std::span{y}) == 6);
+        ASSERT(zzz::reduce(std::plus{}, 0, x) == 15);
+        ASSERT(zzz::reduce(std::plus{}, 0, std::views::iota(1, 4)) == 6);
+    }
     {
         auto const x = std::array<int, 0>{};
         auto const r = zzz::reduce(std::multiplies{}, 1, x);
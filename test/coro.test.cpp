@@ -1,4 +1,10 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <zzz/coro.hpp>
@@ -13,6 +19,72 @@ inline auto numbers(int begin, int end) -> zzz::Generator<int>
     }
 }
 
+namespace {
+
+/// Allocator that counts its live allocations.
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    explicit CountingAllocator(int* live) : live{live} {}
+
+    template <typename U>
+    CountingAllocator(CountingAllocator<U> const& other) : live{other.live}
+    {}
+
+    auto allocate(std::size_t n) -> T*
+    {
+        ++*live;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        --*live;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    auto operator==(CountingAllocator const&) const -> bool = default;
+
+    int* live;
+};
+
+auto counted(std::allocator_arg_t, CountingAllocator<std::byte>, int end)
+    -> zzz::Generator<int>
+{
+    for (int i = 0; i < end; ++i) {
+        co_yield i;
+    }
+}
+
+struct Counter {
+    auto numbers(std::allocator_arg_t, CountingAllocator<std::byte>) const
+        -> zzz::Generator<int>
+    {
+        for (int i = 0; i < end; ++i) {
+            co_yield i;
+        }
+    }
+
+    int end;
+};
+
+/// Yield begin, then everything of the nested chain, then end.
+auto nested_chain(int begin, int end) -> zzz::Generator<int>
+{
+    if (begin == end) co_return;
+    co_yield begin;
+    co_yield zzz::elements_of(nested_chain(begin + 1, end));
+}
+
+auto throw_after(int count) -> zzz::Generator<int>
+{
+    co_yield zzz::elements_of(numbers(0, count));
+    throw std::runtime_error{"nested"};
+}
+
+}  // namespace
+
 TEST(simple_generator)
 {
     {  // l-value generator object
@@ -114,3 +186,111 @@ TEST(filter_with_generator)
         ASSERT(x[4] == 5);
     }
 }
+
+TEST(generator_allocator)
+{
+    auto live = 0;
+    {
+        auto gen = counted(std::allocator_arg, CountingAllocator<std::byte>{&live}, 3);
+        ASSERT(live == 1);
+        auto expected = 0;
+        for (auto i : gen) {
+            ASSERT(i == expected++);
+        }
+        ASSERT(expected == 3);
+    }
+    ASSERT(live == 0);
+    {
+        auto const counter = Counter{4};
+        auto gen =
+            counter.numbers(std::allocator_arg, CountingAllocator<std::byte>{&live});
+        ASSERT(live == 1);
+        ASSERT(std::ranges::distance(gen) == 4);
+    }
+    ASSERT(live == 0);
+}
+
+TEST(generator_frame_pool)
+{
+    using zzz::detail::FramePool;
+
+    // Freed blocks are reused for the same size class.
+    auto const a = FramePool::allocate(100);
+    FramePool::deallocate(a, 100);
+    auto const b = FramePool::allocate(120);
+    ASSERT(a == b);
+    FramePool::deallocate(b, 120);
+
+    auto const large = FramePool::allocate(FramePool::max_size + 1);
+    FramePool::deallocate(large, FramePool::max_size + 1);
+
+    // Frames may be freed on another thread than they were allocated on.
+    auto gen = numbers(0, 3);
+    auto count = std::ptrdiff_t{0};
+    std::thread{[&count, moved = std::move(gen)]() mutable {
+        count = std::ranges::distance(moved);
+    }}.join();
+    ASSERT(count == 3);
+
+    auto other = zzz::Generator<int>{nullptr};
+    std::thread{[&] { other = numbers(0, 2); }}.join();
+    ASSERT(std::ranges::distance(other) == 2);
+}
+
+TEST(generator_elements_of)
+{
+    {
+        auto result = std::vector<int>{};
+        for (auto i : nested_chain(0, 1'000)) {
+            result.push_back(i);
+        }
+        ASSERT(result.size() == 1'000);
+        ASSERT(result.front() == 0 && result.back() == 999);
+        ASSERT(std::ranges::is_sorted(result));
+    }
+    {  // Values before and after, an lvalue generator, and other ranges.
+        auto inner = numbers(1, 3);
+        auto const tail = std::vector<int>{5, 6};
+        auto gen = [](zzz::Generator<int>& inner,
+                      std::vector<int> const& tail) -> zzz::Generator<int> {
+            co_yield 0;
+            co_yield zzz::elements_of(inner);
+            co_yield 3;
+            co_yield zzz::elements_of(std::vector<int>{});
+            co_yield zzz::elements_of(std::views::iota(4, 5));
+            co_yield zzz::elements_of(tail);
+        }(inner, tail);
+        auto result = std::vector<int>{};
+        for (auto i : gen) {
+            result.push_back(i);
+        }
+        ASSERT((result == std::vector<int>{0, 1, 2, 3, 4, 5, 6}));
+    }
+    {  // Destroyed while nested.
+        auto gen = nested_chain(0, 100);
+        auto it = gen.begin();
+        std::ranges::advance(it, 50);
+        ASSERT(*it == 50);
+    }
+}
+
+TEST(generator_exceptions)
+{
+    auto count = 0;
+    ASSERT_THROWS(
+        [&] {
+            for (auto i : throw_after(3)) {
+                ASSERT(i == count++);
+            }
+        }(),
+        std::runtime_error);
+    ASSERT(count == 3);
+
+    // Nested exceptions propagate through the outer generator.
+    auto outer = []() -> zzz::Generator<int> {
+        co_yield zzz::elements_of(throw_after(1));
+    }();
+    auto it = outer.begin();
+    ASSERT(*it == 0);
+    ASSERT_THROWS(++it, std::runtime_error);
+}
@@ -0,0 +1,196 @@
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include <zzz/container.hpp>
+#include <zzz/flat_map.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+/// Hash for heterogeneous lookup of std::string keys.
+struct StringHash {
+    using is_transparent = void;
+    auto operator()(std::string_view x) const -> std::size_t
+    {
+        return std::hash<std::string_view>{}(x);
+    }
+};
+
+/// Hash that sends every key to the same probe sequence.
+struct CollidingHash {
+    auto operator()(int) const -> std::size_t { return 0; }
+};
+
+/// Key ThrowingHash throws on, none if negative.
+int throwing_key = -1;
+
+/// Hash that throws std::runtime_error on throwing_key.
+struct ThrowingHash {
+    auto operator()(int x) const -> std::size_t
+    {
+        if (x == throwing_key) throw std::runtime_error{"ThrowingHash"};
+        return std::hash<int>{}(x);
+    }
+};
+
+}  // namespace
+
+TEST(flat_map_basics)
+{
+    auto x = zzz::FlatMap<int, std::string>{};
+    ASSERT(x.empty());
+    ASSERT(x.find(1) == x.end());
+    ASSERT(x.begin() == x.end());
+
+    ASSERT(x.insert({1, "foo"}).second);
+    ASSERT(x.try_emplace(2, "bar").second);
+    ASSERT(!x.insert({1, "baz"}).second);
+    ASSERT(x.size() == 2);
+    ASSERT(x.find(1)->second == "foo");
+    ASSERT(x.contains(2));
+    ASSERT(!x.contains(3));
+
+    x[3] = "baz";
+    ASSERT(x.at(3) == "baz");
+    ASSERT_THROWS(x.at(4), std::out_of_range);
+
+    ASSERT(!x.insert_or_assign(1, "qux").second);
+    ASSERT(x.at(1) == "qux");
+
+    ASSERT(x.erase(2) == 1);
+    ASSERT(x.erase(2) == 0);
+    ASSERT(!x.contains(2));
+    ASSERT(x.size() == 2);
+
+    auto count = std::size_t{0};
+    for (auto const& [key, value] : x) {
+        ASSERT(x.at(key) == value);
+        ++count;
+    }
+    ASSERT(count == 2);
+
+    x.clear();
+    ASSERT(x.empty());
+    ASSERT(!x.contains(1));
+}
+
+TEST(flat_map_copy_move)
+{
+    auto x = zzz::FlatMap<std::string, int>{{"foo", 1}, {"bar", 2}};
+    auto y = x;
+    y["baz"] = 3;
+    ASSERT(x.size() == 2);
+    ASSERT(y.size() == 3);
+
+    auto z = std::move(y);
+    ASSERT(z.size() == 3);
+    ASSERT(z.at("baz") == 3);
+    ASSERT(y.empty());
+    ASSERT(!y.contains("baz"));
+
+    y = z;
+    ASSERT(y.at("foo") == 1);
+}
+
+TEST(flat_map_erase_while_iterating)
+{
+    auto x = zzz::FlatMap<int, int>{};
+    for (auto i = 0; i < 1'000; ++i) {
+        x[i] = i;
+    }
+    for (auto it = x.begin(); it != x.end();) {
+        it = it->first % 2 == 0 ? x.erase(it) : std::next(it);
+    }
+    ASSERT(x.size() == 500);
+    for (auto i = 0; i < 1'000; ++i) {
+        ASSERT(x.contains(i) == (i % 2 == 1));
+    }
+}
+
+TEST(flat_map_collisions)
+{
+    auto x = zzz::FlatMap<int, int, CollidingHash>{};
+    for (auto i = 0; i < 100; ++i) {
+        x[i] = i * 2;
+    }
+    for (auto i = 0; i < 100; i += 3) {
+        x.erase(i);
+    }
+    for (auto i = 0; i < 100; ++i) {
+        ASSERT(x.contains(i) == (i % 3 != 0));
+    }
+}
+
+TEST(flat_map_resize_throws)
+{
+    auto x = zzz::FlatMap<int, std::string, ThrowingHash>{};
+    for (auto i = 0; i < 100; ++i) {
+        x[i] = std::to_string(i);
+    }
+    throwing_key = 42;
+    ASSERT_THROWS(x.reserve(1000), std::runtime_error);
+    throwing_key = -1;
+
+    ASSERT(x.size() == 100);
+    for (auto i = 0; i < 100; ++i) {
+        ASSERT(x.at(i) == std::to_string(i));
+    }
+    auto count = 0;
+    for (auto const& [key, value] : x) {
+        ASSERT(value == std::to_string(key));
+        ++count;
+    }
+    ASSERT(count == 100);
+    x.reserve(1000);
+    ASSERT(x.at(42) == "42");
+}
+
+TEST(flat_map_matches_unordered_map)
+{
+    auto gen = std::mt19937{42};
+    auto x = zzz::FlatMap<int, int>{};
+    auto y = std::unordered_map<int, int>{};
+
+    // Churn on a small key range reuses erased slots and reclaims them on growth.
+    for (auto i = 0; i < 100'000; ++i) {
+        auto const key = static_cast<int>(gen() % 2'000);
+        auto const op = gen() % 3;
+        if (op == 0) {
+            ASSERT(x.try_emplace(key, i).second == y.try_emplace(key, i).second);
+        }
+        else if (op == 1) {
+            ASSERT(x.erase(key) == y.erase(key));
+        }
+        else {
+            ASSERT(x.contains(key) == y.contains(key));
+        }
+    }
+    ASSERT(x.size() == y.size());
+    for (auto const& [key, value] : y) {
+        ASSERT(x.at(key) == value);
+    }
+}
+
+TEST(flat_map_lookup)
+{
+    auto x = zzz::FlatMap<std::string, int, StringHash, std::equal_to<>>{{"foo", 1},
+                                                                         {"bar", 2}};
+    ASSERT(x.find(std::string_view{"foo"})->second == 1);
+    ASSERT(x.contains("bar"));
+    ASSERT(x.try_emplace(std::string_view{"baz"}, 3).second);
+
+    ASSERT(*zzz::lookup(x, std::string_view{"baz"}) == 3);
+    ASSERT(!zzz::lookup(x, "qux").has_value());
+    *zzz::lookup_ptr(x, "foo") = 4;
+    ASSERT(x.at("foo") == 4);
+
+    auto const y = zzz::FlatMap<std::string, int>{{"foo", 1}};
+    ASSERT(*zzz::lookup(y, std::string_view{"foo"}) == 1);
+    ASSERT(zzz::lookup_ptr(y, "bar") == nullptr);
+}
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <zzz/container.hpp>
+#include <zzz/flat_ordered.hpp>
+#include <zzz/test.hpp>
+
+static_assert(std::ranges::random_access_range<zzz::FlatOrderedMap<int, std::string>>);
+static_assert(
+    std::ranges::random_access_range<zzz::FlatOrderedMap<int, std::string> const>);
+static_assert(std::ranges::sized_range<zzz::FlatOrderedMap<int, std::string> const>);
+
+TEST(branchless_lower_bound)
+{
+    auto gen = std::mt19937{42};
+    for (auto size = std::size_t{0}; size < 70; ++size) {
+        auto x = std::vector<int>(size);
+        for (auto& value : x) {
+            value = static_cast<int>(gen() % 50);
+        }
+        std::sort(x.begin(), x.end());
+        for (auto key = -1; key <= 51; ++key) {
+            auto const expected = std::lower_bound(x.begin(), x.end(), key) - x.begin();
+            ASSERT(zzz::detail::branchless_lower_bound(x.data(), x.size(), key,
+                                                       std::less<>{}) ==
+                   static_cast<std::size_t>(expected));
+        }
+    }
+}
+
+TEST(flat_set)
+{
+    auto x = zzz::FlatSet<int>{5, 3, 9, 3, 1, 5};
+    ASSERT(x.size() == 4);
+    ASSERT(std::is_sorted(x.begin(), x.end()));
+    ASSERT(x.contains(9));
+    ASSERT(!x.contains(4));
+    ASSERT(*x.find(3) == 3);
+    ASSERT(x.find(4) == x.end());
+    ASSERT(*x.lower_bound(4) == 5);
+
+    ASSERT(x.insert(4).second);
+    ASSERT(!x.insert(4).second);
+    ASSERT(x.erase(1) == 1);
+    ASSERT(x.erase(1) == 0);
+    ASSERT((std::vector<int>(x.begin(), x.end()) == std::vector<int>{3, 4, 5, 9}));
+
+    ASSERT(zzz::contains(x, 4));
+    ASSERT(!zzz::contains(x, 1));
+
+    auto const y = zzz::FlatSet<std::string, std::less<>>{"foo", "bar"};
+    ASSERT(y.contains(std::string_view{"bar"}));
+    ASSERT(zzz::contains(y, "foo"));
+    ASSERT(!zzz::contains(y, std::string_view{"baz"}));
+}
+
+TEST(flat_ordered_map)
+{
+    // For equal keys the first one wins.
+    auto x = zzz::FlatOrderedMap<int, std::string>{{4, "baz"}, {1, "foo"}, {2, "bar"},
+                                                   {1, "qux"}};
+    ASSERT(x.size() == 3);
+    ASSERT(x.at(1) == "foo");
+    ASSERT(x.find(2)->second == "bar");
+    ASSERT(x.find(3) == x.end());
+    ASSERT_THROWS(x.at(3), std::out_of_range);
+    ASSERT(std::is_sorted(x.keys().begin(), x.keys().end()));
+
+    ASSERT(x.try_emplace(3, "quux").second);
+    ASSERT(!x.try_emplace(3, "corge").second);
+    ASSERT(x.at(3) == "quux");
+    ASSERT(x.erase(2) == 1);
+    ASSERT(!x.contains(2));
+
+    auto keys = std::vector<int>{};
+    for (auto const& [key, value] : x) {
+        ASSERT(x.at(key) == value);
+        keys.push_back(key);
+    }
+    ASSERT((keys == std::vector<int>{1, 3, 4}));
+
+    x.find(4)->second = "grault";
+    ASSERT(x.at(4) == "grault");
+
+    ASSERT(*zzz::lookup(x, 1) == "foo");
+    ASSERT(!zzz::lookup(x, 2).has_value());
+    *zzz::lookup_ptr(x, 3) = "garply";
+    ASSERT(x.at(3) == "garply");
+    ASSERT(zzz::contains(x, 3));
+}
+
+TEST(flat_ordered_map_iterator)
+{
+    auto x = zzz::FlatOrderedMap<int, std::string>{{3, "baz"}, {1, "foo"}, {2, "bar"}};
+    auto const first = x.begin();
+    ASSERT(x.end() - first == 3);
+    ASSERT((first + 2)->second == "baz");
+    ASSERT(first[1].first == 2);
+    ASSERT(first < x.end() && x.end() - 1 > first);
+    ASSERT((--x.end())->first == 3);
+
+    first[0].second = "qux";
+    ASSERT(x.at(1) == "qux");
+
+    auto const& y = x;
+    auto const values = y | std::views::reverse |
+                        std::views::transform([](auto pair) { return pair.second; });
+    ASSERT((std::vector<std::string>(values.begin(), values.end()) ==
+            std::vector<std::string>{"baz", "bar", "qux"}));
+    ASSERT(std::ranges::lower_bound(y, 2, {}, [](auto pair) { return pair.first; })
+               ->second == "bar");
+}
+
+TEST(flat_ordered_map_heterogeneous)
+{
+    auto const x =
+        zzz::FlatOrderedMap<std::string, int, std::less<>>{{"foo", 1}, {"bar", 2}};
+    ASSERT(x.find(std::string_view{"bar"})->second == 2);
+    ASSERT(*zzz::lookup(x, std::string_view{"foo"}) == 1);
+    ASSERT(zzz::lookup_ptr(x, "baz") == nullptr);
+
+    auto const y = zzz::FlatOrderedMap<std::string, int>{{"foo", 1}};
+    ASSERT(*zzz::lookup(y, std::string_view{"foo"}) == 1);
+}
@@ -1,10 +1,41 @@
 #include <array>
+#include <iomanip>
+#include <locale>
+#include <ostream>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include <zzz/io.hpp>
 #include <zzz/test.hpp>
 
+namespace {
+
+[[nodiscard]] auto numbers(int begin, int end) -> zzz::Generator<int>
+{
+    for (auto i = begin; i < end; ++i) {
+        co_yield i;
+    }
+}
+
+/// Prints its coordinates with zzz::print, nested in the print of a container.
+struct Point {
+    std::vector<int> coordinates;
+};
+
+auto operator<<(std::ostream& os, Point const& x) -> std::ostream&
+{
+    return zzz::print(os, x.coordinates);
+}
+
+/// Groups digits by three with commas.
+struct Thousands : std::numpunct<char> {
+    [[nodiscard]] auto do_thousands_sep() const -> char override { return ','; }
+    [[nodiscard]] auto do_grouping() const -> std::string override { return "\3"; }
+};
+
+}  // namespace
+
 TEST(getline)
 {
     auto is = std::istringstream{"Hello\nWorld\n"};
@@ -37,4 +68,117 @@ TEST(print)
         zzz::print(ss, x);
         ASSERT(ss.str() == "{ a, b, c, d, e }");
     }
+    {  // Input iterators, each element is visited once.
+        auto ss = std::ostringstream{};
+        zzz::print(ss, numbers(1, 5));
+        ASSERT(ss.str() == "{ 1, 2, 3, 4 }");
+    }
+    {  // Same text as operator<< for each element.
+        auto const x = std::vector<double>{0.1, 1.0 / 3.0, 1e-5, 123456789.0, -2.5};
+        auto expected = std::ostringstream{};
+        expected << "{ " << x[0] << ", " << x[1] << ", " << x[2] << ", " << x[3] << ", "
+                 << x[4] << " }";
+        auto ss = std::ostringstream{};
+        zzz::print(ss, x);
+        ASSERT(ss.str() == expected.str());
+    }
+    {  // Stream format flags are respected.
+        auto ss = std::ostringstream{};
+        ss << std::hex << std::boolalpha;
+        zzz::print(ss, std::vector<int>{10, 255});
+        zzz::print(ss, std::vector<bool>{true, false});
+        ASSERT(ss.str() == "{ a, ff }{ true, false }");
+    }
+    {
+        auto ss = std::ostringstream{};
+        zzz::print(ss, std::vector<int>{});
+        zzz::print(ss, std::vector<std::string>{"foo", "bar"});
+        ASSERT(ss.str() == "{  }{ foo, bar }");
+    }
+    {  // Into a reusable string.
+        auto buffer = std::string{"x = "};
+        zzz::print(buffer, std::vector<long>{-1, 0, 1});
+        ASSERT(buffer == "x = { -1, 0, 1 }");
+    }
+    {  // Elements whose operator<< calls print.
+        auto const x = std::vector<Point>{{{1, 2}}, {{3}}};
+        auto ss = std::ostringstream{};
+        zzz::print(ss, x);
+        ss << std::hex;
+        zzz::print(ss, std::vector<Point>{{{10}}});
+        ASSERT(ss.str() == "{ { 1, 2 }, { 3 } }{ { a } }");
+
+        auto buffer = std::string{};
+        zzz::print(buffer, x);
+        ASSERT(buffer == "{ { 1, 2 }, { 3 } }");
+    }
+    {  // The stream's locale is used.
+        auto ss = std::ostringstream{};
+        ss.imbue(std::locale{ss.getloc(), new Thousands});
+        zzz::print(ss, std::vector<int>{1234567, 42});
+        ASSERT(ss.str() == "{ 1,234,567, 42 }");
+    }
+    {  // The width pads the opening brace, as it would with operator<<, then resets.
+        auto ss = std::ostringstream{};
+        ss << std::setw(6) << std::setfill('*');
+        zzz::print(ss, std::vector<int>{1});
+        ASSERT(ss.width() == 0);
+        zzz::print(ss, std::vector<int>{2});
+        ASSERT(ss.str() == "****{ 1 }{ 2 }");
+    }
+#if defined(__cpp_lib_format)
+    {
+        auto ss = std::ostringstream{};
+        zzz::print(ss, std::vector<double>{1.0, 2.5}, "{:.2f}");
+        ASSERT(ss.str() == "{ 1.00, 2.50 }");
+    }
+#endif
+}
+
+TEST(line_reader)
+{
+    auto const read_all = [](std::string const& text, std::size_t buffer_size) {
+        auto is = std::istringstream{text};
+        auto reader = zzz::LineReader{is, '\n', buffer_size};
+        auto result = std::vector<std::string>{};
+        while (auto line = reader.next()) {
+            result.emplace_back(*line);
+        }
+        return result;
+    };
+
+    auto const read_all_getline = [](std::string const& text) {
+        auto is = std::istringstream{text};
+        auto result = std::vector<std::string>{};
+        while (auto line = zzz::getline(is)) {
+            result.push_back(*line);
+        }
+        return result;
+    };
+
+    {
+        auto const lines = read_all("Hello\nWorld\n", 1 << 16);
+        ASSERT(lines.size() == 2);
+        ASSERT(lines[0] == "Hello");
+        ASSERT(lines[1] == "World");
+    }
+    {  // Same lines as zzz::getline, with lines spanning buffer refills.
+        auto const text = std::string{
+            "first\n\nthird line is longer than the buffer\n\n\nx\nno newline"};
+        for (auto buffer_size : {1, 2, 3, 5, 8, 64, 1024}) {
+            ASSERT(read_all(text, buffer_size) == read_all_getline(text));
+            ASSERT(read_all(text + "\n", buffer_size) == read_all_getline(text + "\n"));
+        }
+        ASSERT(read_all("", 4).empty());
+        ASSERT(read_all("\n", 4) == read_all_getline("\n"));
+    }
+    {  // Generator
+        auto is = std::istringstream{"a,b,,c"};
+        auto reader = zzz::LineReader{is, ','};
+        auto result = std::vector<std::string>{};
+        for (auto line : reader.lines()) {
+            result.emplace_back(line);
+        }
+        ASSERT((result == std::vector<std::string>{"a", "b", "", "c"}));
+    }
 }
@@ -0,0 +1,64 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <zzz/mapped_file.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+/// Write \p contents to a new file in the temporary directory, return its path.
+[[nodiscard]] auto write_temp_file(std::string const& name, std::string const& contents)
+    -> std::filesystem::path
+{
+    auto const path = std::filesystem::temp_directory_path() / name;
+    auto os = std::ofstream{path, std::ios::binary};
+    os << contents;
+    return path;
+}
+
+}  // namespace
+
+TEST(mapped_file)
+{
+    {
+        auto const path = write_temp_file("zzz.mapped_file.test.csv", "a,b,c\n1,,3\n");
+        auto file = zzz::MappedFile{path};
+        ASSERT(file.size() == 11);
+        ASSERT(file.view() == "a,b,c\n1,,3\n");
+
+        auto fields = std::vector<std::string_view>{};
+        for (auto line : file.lines()) {
+            for (auto field : zzz::split_view(line, ",")) {
+                fields.push_back(field);
+            }
+        }
+        ASSERT((fields == std::vector<std::string_view>{"a", "b", "c", "1", "", "3"}));
+        ASSERT(std::ranges::distance(file.split("\n")) == 2);
+
+        // A temporary delimiter outlives the loop, the view holds a copy.
+        auto segments = std::vector<std::string_view>{};
+        for (auto segment : file.split(std::string{",,"})) {
+            segments.push_back(segment);
+        }
+        ASSERT((segments == std::vector<std::string_view>{"a,b,c\n1", "3\n"}));
+
+        auto moved = zzz::MappedFile{std::move(file)};
+        ASSERT(moved.view() == "a,b,c\n1,,3\n");
+        ASSERT(file.view().empty());
+        std::filesystem::remove(path);
+    }
+    {
+        auto const path = write_temp_file("zzz.mapped_file.test.empty", "");
+        auto const file = zzz::MappedFile{path, zzz::MappedFile::Access::Random};
+        ASSERT(file.size() == 0);
+        ASSERT(file.view().empty());
+        ASSERT(file.lines().empty());
+        std::filesystem::remove(path);
+    }
+    {
+        ASSERT_THROWS(zzz::MappedFile{"/this/file/does/not/exist"}, std::system_error);
+    }
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <execution>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <zzz/parallel.hpp>
+#include <zzz/parallel_policy.hpp>
+#include <zzz/test.hpp>
+
+TEST(chunk_lines)
+{
+    auto const x = std::string_view{"aa\nbbb\nc\n\ndddd\ne"};
+    for (auto count = std::size_t{1}; count < 20; ++count) {
+        auto const chunks = zzz::chunk_lines(x, count);
+        ASSERT(!chunks.empty());
+        ASSERT(chunks.size() <= count);
+
+        auto joined = std::string{};
+        for (auto i = std::size_t{0}; i < chunks.size(); ++i) {
+            ASSERT(!chunks[i].empty());
+            if (i + 1 != chunks.size()) { ASSERT(chunks[i].back() == '\n'); }
+            joined += chunks[i];
+        }
+        ASSERT(joined == x);
+    }
+    ASSERT(zzz::chunk_lines("", 4).empty());
+}
+
+TEST(reduce_lines)
+{
+    auto text = std::string{};
+    for (auto i = 0; i < 10'000; ++i) {
+        text += std::to_string(i) + (i % 7 == 0 ? "\n\n" : "\n");
+    }
+    text += "10000";  // No trailing newline.
+
+    auto const sum = [](long total, std::string_view line) {
+        return line.empty() ? total : total + std::stol(std::string{line});
+    };
+    auto const expected = 10'000L * 10'001L / 2;
+
+    for (auto chunks : {1, 2, 3, 8, 64}) {
+        auto const n = static_cast<std::size_t>(chunks);
+        ASSERT(zzz::reduce_lines(sum, std::plus{}, 0L, text, n) == expected);
+
+        auto const count = zzz::reduce_lines(
+            [](std::size_t total, std::string_view) { return total + 1; }, std::plus{},
+            std::size_t{0}, text, n);
+        ASSERT(count == zzz::split(text, "\n").size());
+
+        auto lines = std::atomic<std::size_t>{0};
+        zzz::for_each_line(text, [&](std::string_view) { ++lines; }, n);
+        ASSERT(lines == count);
+    }
+
+    {  // Merge is applied in chunk order.
+        auto const joined = zzz::reduce_lines(
+            [](std::string total, std::string_view line) { return total += line; },
+            std::plus{}, std::string{}, "a\nb\nc\nd\ne\n", 3);
+        ASSERT(joined == "abcde");
+    }
+    {
+        ASSERT(zzz::reduce_lines(sum, std::plus{}, 0L, "", 4) == 0);
+        ASSERT_THROWS(zzz::for_each_line("1\n2\nthree\n4\n",
+                                         [](std::string_view line) {
+                                             if (line == "three") {
+                                                 throw std::runtime_error{"three"};
+                                             }
+                                         }),
+                      std::runtime_error);
+    }
+}
+
+TEST(parallel_reduce)
+{
+    auto x = std::vector<int>(100'000);
+    for (auto i = std::size_t{0}; i < x.size(); ++i) {
+        x[i] = static_cast<int>(i % 1'000) - 500;
+    }
+    auto const expected = zzz::reduce(std::plus{}, 7L, x);
+
+    for (auto chunks : {1, 2, 3, 4, 7, 16}) {
+        ASSERT(zzz::reduce(std::plus{}, 7L, x, static_cast<std::size_t>(chunks)) ==
+               expected);
+    }
+    ASSERT(zzz::reduce(std::execution::seq, std::plus{}, 7L, x) == expected);
+    ASSERT(zzz::reduce(std::execution::par, std::plus{}, 7L, x) == expected);
+    ASSERT(zzz::reduce(std::execution::par_unseq, std::plus{}, 7L, x) == expected);
+
+    {  // Small and empty inputs.
+        for (auto size = std::size_t{0}; size < 20; ++size) {
+            auto const y = std::vector<int>(x.begin(), x.begin() + size);
+            ASSERT(zzz::reduce(std::plus{}, 1L, y, 4) ==
+                   zzz::reduce(std::plus{}, 1L, y));
+        }
+    }
+    {  // Arrays and string_views.
+        auto const a = std::array<int, 5>{1, 2, 3, 4, 5};
+        ASSERT(zzz::reduce(std::multiplies{}, 1, a, 2) == 120);
+
+        auto const s = std::string(50'000, 'a');
+        auto const sum =
+            zzz::reduce(std::plus{}, std::size_t{0}, std::string_view{s}, 4);
+        ASSERT(sum == s.size() * 'a');
+    }
+    {  // Max, a different associative and commutative operation.
+        auto const max = [](int a, int b) { return std::max(a, b); };
+        ASSERT(zzz::reduce(max, -1'000, x, 8) == 499);
+    }
+    {  // Partial application keeps working alongside.
+        auto const sum = zzz::reduce(std::plus{}, 0L);
+        ASSERT(sum(x) == expected - 7);
+    }
+}
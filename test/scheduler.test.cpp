@@ -0,0 +1,86 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <zzz/scheduler.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+auto worker_id(zzz::Scheduler& scheduler) -> zzz::Task<std::thread::id>
+{
+    co_await scheduler.schedule();
+    co_return std::this_thread::get_id();
+}
+
+/// Count the leaves of a tree of tasks \p depth levels deep, \p width wide.
+auto count_leaves(zzz::Scheduler& scheduler, int depth, int width) -> zzz::Task<long>
+{
+    co_await scheduler.schedule();
+    if (depth == 0) co_return 1;
+
+    auto children = std::vector<zzz::Task<long>>{};
+    for (auto i = 0; i < width; ++i) {
+        children.push_back(count_leaves(scheduler, depth - 1, width));
+    }
+    auto sum = 0L;
+    for (auto count : co_await zzz::when_all(std::move(children))) {
+        sum += count;
+    }
+    co_return sum;
+}
+
+auto fail_on_worker(zzz::Scheduler& scheduler) -> zzz::Task<>
+{
+    co_await scheduler.schedule();
+    throw std::runtime_error{"worker"};
+}
+
+auto add_one(zzz::Scheduler& scheduler, std::atomic<int>& x) -> zzz::Task<>
+{
+    co_await scheduler.schedule();
+    ++x;
+}
+
+}  // namespace
+
+TEST(scheduler)
+{
+    auto scheduler = zzz::Scheduler{4};
+    ASSERT(scheduler.thread_count() == 4);
+
+    ASSERT(zzz::sync_wait(worker_id(scheduler)) != std::this_thread::get_id());
+    ASSERT(zzz::sync_wait(count_leaves(scheduler, 6, 4)) == 4096);
+    ASSERT_THROWS(zzz::sync_wait(fail_on_worker(scheduler)), std::runtime_error);
+
+    auto x = std::atomic<int>{0};
+    auto tasks = std::vector<zzz::Task<>>{};
+    for (auto i = 0; i < 10'000; ++i) {
+        tasks.push_back(add_one(scheduler, x));
+    }
+    zzz::sync_wait(zzz::when_all(std::move(tasks)));
+    ASSERT(x.load() == 10'000);
+}
+
+TEST(scheduler_threads)
+{
+    // Tasks started from several threads at once, onto a single worker too.
+    for (auto thread_count : {std::size_t{1}, std::size_t{3}}) {
+        auto scheduler = zzz::Scheduler{thread_count};
+        auto x = std::atomic<int>{0};
+        {
+            auto threads = std::vector<std::jthread>{};
+            for (auto i = 0; i < 4; ++i) {
+                threads.emplace_back([&] {
+                    for (auto j = 0; j < 1'000; ++j) {
+                        zzz::sync_wait(add_one(scheduler, x));
+                    }
+                });
+            }
+        }
+        ASSERT(x.load() == 4'000);
+        ASSERT(zzz::sync_wait(count_leaves(scheduler, 3, 5)) == 125);
+    }
+}
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <zzz/search.hpp>
+#include <zzz/simd.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+/// Random bytes from the first \p alphabet letters, so that matches are likely.
+[[nodiscard]] auto random_bytes(std::mt19937& gen, std::size_t size, char alphabet)
+    -> std::string
+{
+    auto dist = std::uniform_int_distribution<int>{'a', 'a' + alphabet - 1};
+    auto result = std::string(size, '\0');
+    for (auto& c : result) {
+        c = static_cast<char>(dist(gen));
+    }
+    return result;
+}
+
+/// Return true if the Searcher finds the same position as std::search.
+[[nodiscard]] auto same_as_search(std::string_view x, std::string_view needle) -> bool
+{
+    auto const expected = std::search(x.begin(), x.end(), needle.begin(), needle.end());
+    return zzz::Searcher{needle}(x) == expected;
+}
+
+}  // namespace
+
+TEST(searcher_basic)
+{
+    ASSERT(same_as_search("foobarbaz", "bar"));
+    ASSERT(same_as_search("foobarbaz", "baz"));
+    ASSERT(same_as_search("foobarbaz", "foobarbaz"));
+    ASSERT(same_as_search("foobarbaz", "foobarbazz"));
+    ASSERT(same_as_search("foobarbaz", ""));
+    ASSERT(same_as_search("", ""));
+    ASSERT(same_as_search("", "foo"));
+
+    auto const searcher = zzz::Searcher{"bar"};
+    ASSERT(searcher.needle() == "bar");
+    ASSERT(searcher("foobarbaz") - std::string_view{"foobarbaz"}.begin() == 3);
+}
+
+TEST(searcher_differential)
+{
+    auto gen = std::mt19937{2024};
+    for (auto i = 0; i < 2'000; ++i) {
+        auto const alphabet = static_cast<char>(i % 2 == 0 ? 1 + gen() % 4 : 26);
+        auto const x = random_bytes(gen, gen() % 400, alphabet);
+        auto const needle = random_bytes(gen, 1 + gen() % 80, alphabet);
+        ASSERT(same_as_search(x, needle));
+
+        // Needles taken from the haystack always match.
+        if (x.size() > 1) {
+            auto const at = gen() % x.size();
+            auto const size = 1 + gen() % std::min<std::size_t>(x.size() - at, 100);
+            ASSERT(same_as_search(x, std::string_view{x}.substr(at, size)));
+        }
+    }
+}
+
+TEST(searcher_periodic)
+{
+    auto const x = std::string(1'000, 'a') + "b" + std::string(100, 'a');
+    for (auto size : {2, 31, 32, 33, 64, 200}) {
+        ASSERT(same_as_search(x, std::string(size, 'a') + "b"));
+        ASSERT(same_as_search(x, "b" + std::string(size, 'a')));
+        ASSERT(same_as_search(x, std::string(size, 'a') + "c"));
+    }
+    auto ab = std::string{};
+    for (auto i = 0; i < 100; ++i) {
+        ab += "ab";
+    }
+    ASSERT(same_as_search(ab + "c" + ab + "abc", ab + "abc"));
+    ASSERT(same_as_search(ab + "c" + ab + "abc", "ab" + ab + "abc"));
+}
+
+TEST(find_segment_kernels)
+{
+    auto gen = std::mt19937{99};
+    for (auto i = 0; i < 2'000; ++i) {
+        auto const x = random_bytes(gen, gen() % 200, 3);
+        auto const needle = random_bytes(gen, 2 + gen() % 6, 3);
+        auto const first = x.data();
+        auto const last = first + x.size();
+        auto const expected = std::search(first, last, needle.begin(), needle.end());
+        ASSERT(zzz::detail::find_segment_scalar(first, last, needle) == expected);
+        ASSERT(zzz::detail::find_segment(first, last, needle) == expected);
+#if defined(ZZZ_SIMD_X86)
+        if (zzz::detail::is_supported(zzz::detail::Isa::SSE2)) {
+            ASSERT(zzz::detail::find_segment_sse2(first, last, needle) == expected);
+        }
+        if (zzz::detail::is_supported(zzz::detail::Isa::AVX2)) {
+            ASSERT(zzz::detail::find_segment_avx2(first, last, needle) == expected);
+        }
+#endif
+    }
+}
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <zzz/container.hpp>
+#include <zzz/simd.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+/// Random bytes from a small alphabet, so that matches are likely.
+[[nodiscard]] auto random_bytes(std::mt19937& gen, std::size_t size) -> std::string
+{
+    auto dist = std::uniform_int_distribution<int>{'a', 'h'};
+    auto result = std::string(size, '\0');
+    for (auto& c : result) {
+        c = static_cast<char>(dist(gen));
+    }
+    return result;
+}
+
+/// Random values from a small set including the extremes of \p T, so that matches
+/// are likely and sign handling is exercised.
+template <typename T>
+[[nodiscard]] auto random_values(std::mt19937& gen, std::size_t size) -> std::vector<T>
+{
+    auto const pool = std::vector<T>{T{0}, T{1}, T{7}, std::numeric_limits<T>::max(),
+                                     std::numeric_limits<T>::lowest()};
+    auto result = std::vector<T>(size);
+    for (auto& x : result) {
+        x = pool[gen() % pool.size()];
+    }
+    return result;
+}
+
+/// Compare every find_value and find_all_values kernel for \p T to std::find.
+template <typename T>
+void check_find_value_kernels(std::vector<T> const& x, T value)
+{
+    using namespace zzz::detail;
+
+    auto const first = x.data();
+    auto const last = x.data() + x.size();
+    auto const expected = std::find(first, last, value);
+    ASSERT(find_value_scalar(first, last, value) == expected);
+    ASSERT(find_value(first, last, value) == expected);
+
+    auto expected_bits = std::vector<std::uint64_t>((x.size() + 63) / 64);
+    for (auto i = std::size_t{0}; i < x.size(); ++i) {
+        if (x[i] == value) expected_bits[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+    auto bits = std::vector<std::uint64_t>(expected_bits.size());
+    find_all_values(first, x.size(), value, bits.data());
+    ASSERT(bits == expected_bits);
+
+#if defined(ZZZ_SIMD_X86)
+    if (is_supported(Isa::SSE2)) {
+        ASSERT(find_value_sse2(first, last, value) == expected);
+        std::fill(bits.begin(), bits.end(), 0);
+        find_all_values_sse2(first, 0, x.size(), value, bits.data());
+        ASSERT(bits == expected_bits);
+    }
+    if (is_supported(Isa::AVX2)) {
+        ASSERT(find_value_avx2(first, last, value) == expected);
+        std::fill(bits.begin(), bits.end(), 0);
+        find_all_values_avx2(first, 0, x.size(), value, bits.data());
+        ASSERT(bits == expected_bits);
+    }
+#endif
+}
+
+template <typename T>
+void check_find_value_kernels(std::mt19937& gen)
+{
+    for (auto size = std::size_t{0}; size < 150; ++size) {
+        auto const x = random_values<T>(gen, size);
+        for (auto value : {T{0}, T{7}, T{42}, std::numeric_limits<T>::max(),
+                           std::numeric_limits<T>::lowest()}) {
+            check_find_value_kernels(x, value);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(find_byte_differential)
+{
+    auto gen = std::mt19937{12345};
+    for (auto size = std::size_t{0}; size < 300; ++size) {
+        auto const bytes = random_bytes(gen, size);
+        for (auto offset = std::size_t{0}; offset < std::min<std::size_t>(size, 33);
+             offset += 7) {
+            auto const first = bytes.data() + offset;
+            auto const last = bytes.data() + bytes.size();
+            for (auto c : {'a', 'c', 'h', 'z', '\0', '\xff'}) {
+                auto const expected = std::find(first, last, c);
+                ASSERT(zzz::detail::find_byte_scalar(first, last, c) == expected);
+                ASSERT(zzz::detail::find_byte(first, last, c) == expected);
+#if defined(ZZZ_SIMD_X86)
+                if (zzz::detail::is_supported(zzz::detail::Isa::SSE2)) {
+                    ASSERT(zzz::detail::find_byte_sse2(first, last, c) == expected);
+                }
+                if (zzz::detail::is_supported(zzz::detail::Isa::AVX2)) {
+                    ASSERT(zzz::detail::find_byte_avx2(first, last, c) == expected);
+                }
+#endif
+            }
+        }
+    }
+}
+
+TEST(find_char_differential)
+{
+    auto gen = std::mt19937{54321};
+    for (auto i = 0; i < 200; ++i) {
+        auto const x = random_bytes(gen, static_cast<std::size_t>(gen() % 1'000));
+        auto const view = std::string_view{x};
+        for (auto c : {'b', 'g', 'x'}) {
+            ASSERT(zzz::find(view, c) == std::find(view.begin(), view.end(), c));
+        }
+    }
+}
+
+TEST(ascii_flip_case_kernels)
+{
+    auto gen = std::mt19937{777};
+    auto dist = std::uniform_int_distribution<int>{0, 255};
+    for (auto size = std::size_t{0}; size < 100; ++size) {
+        auto x = std::string(size, '\0');
+        for (auto& c : x) {
+            c = static_cast<char>(dist(gen));
+        }
+        auto expected = std::string(size, '\0');
+        zzz::detail::ascii_flip_case_scalar(x.data(), size, expected.data(), 'a', 'z');
+
+        auto result = std::string(size, '\0');
+        zzz::detail::ascii_flip_case(x.data(), size, result.data(), 'a', 'z');
+        ASSERT(result == expected);
+#if defined(ZZZ_SIMD_X86)
+        if (zzz::detail::is_supported(zzz::detail::Isa::SSE2)) {
+            zzz::detail::ascii_flip_case_sse2(x.data(), size, result.data(), 'a', 'z');
+            ASSERT(result == expected);
+        }
+        if (zzz::detail::is_supported(zzz::detail::Isa::AVX2)) {
+            zzz::detail::ascii_flip_case_avx2(x.data(), size, result.data(), 'a', 'z');
+            ASSERT(result == expected);
+        }
+#endif
+    }
+}
+
+TEST(find_value_kernels)
+{
+    auto gen = std::mt19937{2024};
+    check_find_value_kernels<char>(gen);
+    check_find_value_kernels<std::int8_t>(gen);
+    check_find_value_kernels<std::uint8_t>(gen);
+    check_find_value_kernels<std::int16_t>(gen);
+    check_find_value_kernels<std::uint16_t>(gen);
+    check_find_value_kernels<std::int32_t>(gen);
+    check_find_value_kernels<std::uint32_t>(gen);
+    check_find_value_kernels<std::int64_t>(gen);
+    check_find_value_kernels<std::uint64_t>(gen);
+    check_find_value_kernels<float>(gen);
+    check_find_value_kernels<double>(gen);
+}
+
+TEST(find_value_floating_point)
+{
+    // Same semantics as operator==, not a bitwise compare.
+    auto const nan = std::numeric_limits<double>::quiet_NaN();
+    auto const x = std::vector<double>{1.0, nan, 2.0, nan, -0.0, 3.0, 4.0, 5.0, 6.0};
+    check_find_value_kernels(x, nan);
+    check_find_value_kernels(x, 0.0);
+    ASSERT(!zzz::contains(x, nan));
+    ASSERT(zzz::find(x, 0.0) - x.begin() == 4);
+}
@@ -1,3 +1,10 @@
+#include <array>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include <zzz/string.hpp>
 #include <zzz/test.hpp>
 
@@ -111,4 +118,114 @@ TEST(uppercase_lowercase)
         auto y = std::string{""};
         ASSERT(zzz::lowercase(y) == "");
     }
-}
\ No newline at end of file
+    {  // Longer than a vector register, non-letters and non-ASCII bytes untouched.
+        auto const x = std::string{"The Quick Brown Fox @[`{ Jumps Over 123 \xc3\xa9 "
+                                   "The Lazy Dog, the quick brown fox. AZaz"};
+        ASSERT(zzz::uppercase(x) == "THE QUICK BROWN FOX @[`{ JUMPS OVER 123 \xc3\xa9 "
+                                    "THE LAZY DOG, THE QUICK BROWN FOX. AZAZ");
+        ASSERT(zzz::lowercase(x) == "the quick brown fox @[`{ jumps over 123 \xc3\xa9 "
+                                    "the lazy dog, the quick brown fox. azaz");
+    }
+    {  // In place.
+        auto x = std::string{"fooBar123, The Quick Brown Fox Jumps Over The Lazy Dog"};
+        zzz::uppercase_in_place(x);
+        ASSERT(x == "FOOBAR123, THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG");
+        zzz::lowercase_in_place(x);
+        ASSERT(x == "foobar123, the quick brown fox jumps over the lazy dog");
+    }
+    {  // Caller provided buffer.
+        auto buffer = std::array<char, 16>{};
+        auto const upper = zzz::uppercase("fooBar123", buffer);
+        ASSERT((std::string_view{upper.data(), upper.size()} == "FOOBAR123"));
+        auto const lower = zzz::lowercase("FOoBAR123", buffer);
+        ASSERT((std::string_view{lower.data(), lower.size()} == "foobar123"));
+        ASSERT_THROWS(zzz::uppercase("this does not fit in 16", buffer),
+                      std::runtime_error);
+    }
+    {  // Every byte value, against the "C" locale.
+        auto x = std::string(256, '\0');
+        for (auto i = 0; i < 256; ++i) {
+            x[static_cast<std::size_t>(i)] = static_cast<char>(i);
+        }
+        auto const upper = zzz::uppercase(x);
+        auto const lower = zzz::lowercase(x);
+        for (auto i = std::size_t{0}; i < x.size(); ++i) {
+            auto const c = static_cast<unsigned char>(x[i]);
+            ASSERT(upper[i] == static_cast<char>(c < 128 ? std::toupper(c) : c));
+            ASSERT(lower[i] == static_cast<char>(c < 128 ? std::tolower(c) : c));
+        }
+    }
+}
+TEST(split_view)
+{
+    auto const same_as_split = [](std::string_view x, std::string_view delimiter) {
+        auto const expected = zzz::split(x, delimiter);
+        auto i = std::size_t{0};
+        for (auto segment : zzz::split_view(x, delimiter)) {
+            if (i == expected.size() || segment != expected[i]) { return false; }
+            ++i;
+        }
+        return i == expected.size();
+    };
+
+    ASSERT(same_as_split("foo bar baz", " "));
+    ASSERT(same_as_split("foo, bar, baz", ", "));
+    ASSERT(same_as_split("foobarbaz", " "));
+    ASSERT(same_as_split("foo:::::bar:::baz", ":"));
+    ASSERT(same_as_split(",foo,,bar,", ","));
+    ASSERT(same_as_split("", ","));
+    ASSERT(same_as_split(",", ","));
+
+    {
+        auto const x = zzz::split_view("foo,bar,baz", ",");
+        auto it = x.begin();
+        ASSERT(*it == "foo");
+        ASSERT(*++it == "bar");
+        ASSERT(*++it == "baz");
+        ASSERT(++it == x.end());
+    }
+    {  // Composes with std::views, only evaluates what is needed.
+        auto const x = std::string{"a b c d e f"};
+        auto first_two = zzz::split_view(x) | std::views::take(2);
+        auto count = 0;
+        for (auto segment : first_two) {
+            ASSERT(segment == (count == 0 ? "a" : "b"));
+            ++count;
+        }
+        ASSERT(count == 2);
+    }
+    {
+        ASSERT(zzz::split_view("", ",").empty());
+        ASSERT(std::ranges::distance(zzz::split_view("a,b,,c", ",")) == 4);
+    }
+    {
+        ASSERT_THROWS(zzz::split_view("foo,bar,baz", ""), std::runtime_error);
+    }
+    {  // Iterators survive moving the view, also with a compiled delimiter.
+        auto const delimiter = std::string(40, '-');
+        auto const x = "foo" + delimiter + "bar" + delimiter + "baz";
+        ASSERT(same_as_split(x, delimiter));
+        for (auto const d : {std::string_view{delimiter}, std::string_view{"-"}}) {
+            auto view = zzz::split_view(x, d);
+            auto it = view.begin();
+            auto moved = std::move(view);
+            ASSERT(*it == "foo");
+            ++it;
+            ASSERT(d.size() == 1 ? *it == "" : *it == "bar");
+            ASSERT(std::ranges::distance(moved) == (d.size() == 1 ? 81 : 3));
+        }
+    }
+    {  // The view owns its delimiter, a temporary one doesn't dangle.
+        for (auto const size : {std::size_t{1}, std::size_t{32}, std::size_t{40}}) {
+            auto const x = "foo" + std::string(size, ',') + "bar";
+            auto segments = std::vector<std::string_view>{};
+            for (auto segment : zzz::split_view(x, std::string(size, ','))) {
+                segments.push_back(segment);
+            }
+            ASSERT((segments == std::vector<std::string_view>{"foo", "bar"}));
+
+            auto const view = zzz::split_view(x, std::string(size, ','));
+            ASSERT(std::ranges::distance(view) == 2);
+        }
+    }
+}
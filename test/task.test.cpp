@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <zzz/task.hpp>
+#include <zzz/test.hpp>
+
+namespace {
+
+auto square(int x) -> zzz::Task<int>
+{
+    co_return x * x;
+}
+
+auto sum_of_squares(int n) -> zzz::Task<int>
+{
+    auto sum = 0;
+    for (auto i = 0; i < n; ++i) {
+        sum += co_await square(i);
+    }
+    co_return sum;
+}
+
+/// Await a chain of \p depth tasks.
+auto chain(int depth) -> zzz::Task<int>
+{
+    if (depth == 0) co_return 0;
+    co_return 1 + co_await chain(depth - 1);
+}
+
+auto fail(std::string message) -> zzz::Task<int>
+{
+    throw std::runtime_error{message};
+    co_return 0;
+}
+
+auto increment(int& x) -> zzz::Task<>
+{
+    ++x;
+    co_return;
+}
+
+auto name() -> zzz::Task<std::string>
+{
+    co_return "first";
+}
+
+auto select(std::vector<int>& x, std::size_t i) -> zzz::Task<int&>
+{
+    co_return x[i];
+}
+
+}  // namespace
+
+TEST(task)
+{
+    ASSERT(zzz::sync_wait(square(7)) == 49);
+    ASSERT(zzz::sync_wait(sum_of_squares(4)) == 14);
+    ASSERT(zzz::sync_wait(chain(1'000)) == 1'000);
+
+    auto x = 0;
+    zzz::sync_wait(increment(x));
+    ASSERT(x == 1);
+
+    auto values = std::vector<int>{1, 2, 3};
+    zzz::sync_wait(select(values, 1)) = 5;
+    ASSERT(values[1] == 5);
+
+    ASSERT_THROWS(zzz::sync_wait(fail("oops")), std::runtime_error);
+
+    // Lazy, nothing runs until awaited.
+    auto task = increment(x);
+    ASSERT(!task.is_ready());
+    ASSERT(x == 1);
+    zzz::sync_wait(std::move(task));
+    ASSERT(x == 2);
+
+    ASSERT_THROWS(zzz::sync_wait(zzz::Task<int>{}), std::runtime_error);
+}
+
+TEST(when_all)
+{
+    auto x = 0;
+    auto const [a, b, c] =
+        zzz::sync_wait(zzz::when_all(square(3), increment(x), name()));
+    ASSERT(a == 9);
+    ASSERT(b == std::monostate{});
+    ASSERT(c == "first");
+    ASSERT(x == 1);
+
+    auto tasks = std::vector<zzz::Task<int>>{};
+    for (auto i = 0; i < 100; ++i) {
+        tasks.push_back(square(i));
+    }
+    auto const squares = zzz::sync_wait(zzz::when_all(std::move(tasks)));
+    ASSERT(squares.size() == 100);
+    ASSERT(squares[12] == 144);
+
+    auto increments = std::vector<zzz::Task<>>{};
+    for (auto i = 0; i < 10; ++i) {
+        increments.push_back(increment(x));
+    }
+    zzz::sync_wait(zzz::when_all(std::move(increments)));
+    ASSERT(x == 11);
+
+    ASSERT(zzz::sync_wait(zzz::when_all()) == std::tuple<>{});
+    ASSERT_THROWS(zzz::sync_wait(zzz::when_all(square(1), fail("oops"))),
+                  std::runtime_error);
+}
@@ -0,0 +1,100 @@
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <zzz/test.hpp>
+#include <zzz/thread_pool.hpp>
+
+TEST(thread_pool)
+{
+    auto pool = zzz::ThreadPool{4};
+    ASSERT(pool.thread_count() == 4);
+
+    auto id = pool.submit([] { return std::this_thread::get_id(); });
+    ASSERT(id.get() != std::this_thread::get_id());
+
+    auto moved = pool.submit([p = std::make_unique<int>(7)] { return *p; });
+    ASSERT(moved.get() == 7);
+
+    auto failed = pool.submit([] { throw std::runtime_error{"job"}; });
+    ASSERT_THROWS(failed.get(), std::runtime_error);
+
+    auto futures = std::vector<std::future<int>>{};
+    for (auto i = 0; i < 10'000; ++i) {
+        futures.push_back(pool.submit([i] { return i; }));
+    }
+    auto sum = 0L;
+    for (auto& future : futures) {
+        sum += future.get();
+    }
+    ASSERT(sum == 10'000L * 9'999 / 2);
+}
+
+TEST(thread_pool_post)
+{
+    // Jobs posted from a job go to the worker's deque, the others steal them, and
+    // the destructor runs them all.
+    auto x = std::atomic<int>{0};
+    {
+        auto pool = zzz::ThreadPool{4};
+        for (auto i = 0; i < 100; ++i) {
+            pool.post([&] {
+                for (auto j = 0; j < 100; ++j) {
+                    pool.post([&] { ++x; });
+                }
+            });
+        }
+    }
+    ASSERT(x.load() == 10'000);
+}
+
+TEST(thread_pool_parallel_for)
+{
+    auto pool = zzz::ThreadPool{4};
+    auto values = std::vector<int>(100'000, 0);
+    pool.parallel_for(0, values.size(), [&](std::size_t i) { values[i] += 1; });
+    ASSERT(std::reduce(values.begin(), values.end()) == 100'000);
+
+    pool.parallel_for(10, 20, [&](std::size_t i) { values[i] += 1; }, 3);
+    ASSERT(std::reduce(values.begin(), values.end()) == 100'010);
+    ASSERT(values[9] == 1 && values[10] == 2 && values[19] == 2 && values[20] == 1);
+
+    pool.parallel_for(5, 5, [&](std::size_t) { values[0] = 0; });
+    ASSERT(values[0] == 1);
+
+    auto calls = std::atomic<std::size_t>{0};
+    ASSERT_THROWS(pool.parallel_for(0,
+                                    1'000,
+                                    [&](std::size_t i) {
+                                        ++calls;
+                                        if (i == 0) { throw std::runtime_error{"i"}; }
+                                    }),
+                  std::runtime_error);
+    ASSERT(calls.load() < 1'000);
+
+    // Nested in a job, with a single worker, so the waiting worker must help.
+    auto single = zzz::ThreadPool{1};
+    auto nested = single.submit([&] {
+        auto sum = std::atomic<std::size_t>{0};
+        single.parallel_for(0, 1'000, [&](std::size_t i) { sum += i; }, 1);
+        return sum.load();
+    });
+    ASSERT(nested.get() == 1'000 * 999 / 2);
+}
+
+TEST(thread_pool_pin_threads)
+{
+    auto pool = zzz::ThreadPool{2, zzz::ThreadPool::Options{.pin_threads = true}};
+    auto ids = std::vector<std::future<std::thread::id>>{};
+    for (auto i = 0; i < 100; ++i) {
+        ids.push_back(pool.submit([] { return std::this_thread::get_id(); }));
+    }
+    for (auto& id : ids) {
+        ASSERT(id.get() != std::this_thread::get_id());
+    }
+}
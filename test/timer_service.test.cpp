@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <zzz/test.hpp>
+#include <zzz/timer_service.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Wait up to a second for \p done to be true.
+template <typename F>
+auto eventually(F const& done) -> bool
+{
+    auto const deadline = std::chrono::steady_clock::now() + 1s;
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) { return false; }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(timer_service)
+{
+    auto service = zzz::TimerService{};
+    auto fired = std::atomic<int>{0};
+
+    auto once = service.schedule_after(5ms, [&] { ++fired; });
+    ASSERT(once.is_pending());
+    ASSERT(eventually([&] { return fired.load() == 1; }));
+    ASSERT(!once.is_pending());
+    ASSERT(!once.cancel());
+
+    auto ticks = std::atomic<int>{0};
+    auto periodic = service.schedule_every(2ms, [&] { ++ticks; });
+    ASSERT(eventually([&] { return ticks.load() >= 5; }));
+    ASSERT(periodic.is_pending());
+    ASSERT(periodic.cancel());
+    auto const stopped_at = ticks.load();
+    std::this_thread::sleep_for(10ms);
+    ASSERT(ticks.load() == stopped_at);
+
+    {  // Destroying the handle cancels.
+        auto const cancelled = service.schedule_after(5ms, [&] { ++fired; });
+    }
+    service.schedule_after(1ms, [&] { ++fired; }).release();
+    ASSERT(eventually([&] { return fired.load() == 2; }));
+    std::this_thread::sleep_for(10ms);
+    ASSERT(fired.load() == 2);
+    ASSERT(service.size() == 0);
+}
+
+TEST(timer_service_order)
+{
+    // A fine tick, so the delays span several levels of the wheel.
+    auto service = zzz::TimerService{10us};
+    auto gen = std::mt19937{42};
+    auto const start = std::chrono::steady_clock::now();
+
+    auto mutex = std::mutex{};
+    auto not_early = std::vector<bool>{};
+    auto handles = std::vector<zzz::TimerService::Handle>{};
+    for (auto i = 0; i < 1'000; ++i) {
+        auto const delay = std::chrono::microseconds{gen() % 200'000};
+        handles.push_back(service.schedule_after(delay, [&, delay] {
+            auto const lock = std::lock_guard{mutex};
+            not_early.push_back(std::chrono::steady_clock::now() - start >= delay);
+        }));
+    }
+    // Cancel every other one.
+    auto cancelled = std::size_t{0};
+    for (auto i = std::size_t{0}; i < handles.size(); i += 2) {
+        cancelled += handles[i].cancel();
+    }
+    ASSERT(eventually([&] { return service.size() == 0; }));
+
+    auto const lock = std::lock_guard{mutex};
+    ASSERT(not_early.size() == handles.size() - cancelled);
+    ASSERT(std::find(not_early.begin(), not_early.end(), false) == not_early.end());
+}
+
+TEST(timer_service_reschedule)
+{
+    auto service = zzz::TimerService{};
+    auto count = std::atomic<int>{0};
+    auto handle = zzz::TimerService::Handle{};
+
+    // Callbacks may schedule timers and cancel their own.
+    auto chained = service.schedule_after(1ms, [&] {
+        ++count;
+        handle = service.schedule_every(1ms, [&] {
+            if (++count == 5) { handle.cancel(); }
+        });
+    });
+    ASSERT(eventually([&] { return count.load() == 5; }));
+    std::this_thread::sleep_for(10ms);
+    ASSERT(count.load() == 5);
+    ASSERT(service.size() == 0);
+}
+
+TEST(timer_service_overrun)
+{
+    auto service = zzz::TimerService{};
+    auto mutex = std::mutex{};
+    auto calls = std::vector<std::chrono::steady_clock::time_point>{};
+    auto first_done = std::chrono::steady_clock::time_point{};
+
+    // The first call overruns about 20 periods, they are skipped rather than run
+    // back to back once it returns.
+    auto handle = service.schedule_every(1ms, [&] {
+        auto const lock = std::lock_guard{mutex};
+        calls.push_back(std::chrono::steady_clock::now());
+        if (calls.size() == 1) {
+            std::this_thread::sleep_for(20ms);
+            first_done = std::chrono::steady_clock::now();
+        }
+    });
+    ASSERT(eventually([&] {
+        auto const lock = std::lock_guard{mutex};
+        return calls.size() >= 25;
+    }));
+    handle.cancel();
+
+    auto const lock = std::lock_guard{mutex};
+    auto const burst = std::count_if(calls.begin() + 1, calls.end(), [&](auto at) {
+        return at < first_done + 5ms;
+    });
+    ASSERT(burst < 10);
+}
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <zzz/test.hpp>
+#include <zzz/timer_thread.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = zzz::TimerThread::ClockType;
+
+/// Wait up to a second for \p done to be true.
+template <typename F>
+auto eventually(F const& done) -> bool
+{
+    auto const deadline = Clock::now() + 1s;
+    while (!done()) {
+        if (Clock::now() > deadline) { return false; }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+struct Calls {
+    std::vector<Clock::time_point> starts;
+    Clock::time_point slow_end;
+    zzz::TimerThread::Stats stats;
+};
+
+/// Run a 10ms timer whose first call takes 55ms until it has made 6 calls.
+auto overrun(zzz::TimerThread::MissedTicks missed_ticks) -> Calls
+{
+    auto mutex = std::mutex{};
+    auto calls = Calls{};
+    auto timer = zzz::TimerThread{
+        10ms,
+        [&] {
+            auto const now = Clock::now();
+            auto const lock = std::lock_guard{mutex};
+            calls.starts.push_back(now);
+            if (calls.starts.size() == 1) {
+                std::this_thread::sleep_for(55ms);
+                calls.slow_end = Clock::now();
+            }
+        },
+        zzz::TimerThread::Options{.missed_ticks = missed_ticks}};
+    eventually([&] {
+        auto const lock = std::lock_guard{mutex};
+        return calls.starts.size() >= 6;
+    });
+    timer.request_stop();
+    // Let the call running, if any, finish.
+    eventually([&] {
+        auto const lock = std::lock_guard{mutex};
+        calls.stats = timer.stats();
+        return calls.stats.calls == calls.starts.size();
+    });
+    return calls;
+}
+
+}  // namespace
+
+TEST(timer_thread)
+{
+    auto mutex = std::mutex{};
+    auto times = std::vector<Clock::time_point>{};
+    auto const start = Clock::now();
+    {
+        auto timer = zzz::TimerThread{10ms, [&] {
+                                          auto const lock = std::lock_guard{mutex};
+                                          times.push_back(Clock::now());
+                                      }};
+        ASSERT(eventually([&] {
+            auto const lock = std::lock_guard{mutex};
+            return times.size() >= 5;
+        }));
+    }
+
+    auto const lock = std::lock_guard{mutex};
+    auto const count = times.size();
+    ASSERT(count >= 5);
+    // Deadlines are absolute, so the callbacks don't drift later period by period.
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        ASSERT(times[i] >= start + 10ms * (i + 1));
+    }
+    ASSERT(times.back() - start < 10ms * count + 100ms);
+}
+
+TEST(timer_thread_stop)
+{
+    // A stop interrupts the wait, it doesn't have to run out first.
+    auto called = std::atomic<bool>{false};
+    auto const start = Clock::now();
+    {
+        auto timer = zzz::TimerThread{1h, [&] { called = true; }};
+        std::this_thread::sleep_for(5ms);
+    }
+    ASSERT(!called);
+    ASSERT(Clock::now() - start < 1s);
+
+    auto timer = zzz::TimerThread{1h, [&] { called = true; }};
+    timer.request_stop();
+    timer = zzz::TimerThread{};
+    ASSERT(!called);
+}
+
+TEST(timer_thread_spin)
+{
+    auto mutex = std::mutex{};
+    auto lateness = std::vector<Clock::duration>{};
+    auto const start = Clock::now();
+    {
+        auto const period = std::chrono::microseconds{500};
+        auto calls = 0;
+        auto timer = zzz::TimerThread{
+            period,
+            [&] {
+                auto const now = Clock::now();
+                auto const lock = std::lock_guard{mutex};
+                lateness.push_back(now - (start + period * ++calls));
+            },
+            zzz::TimerThread::Options{.spin = 200us}};
+        ASSERT(eventually([&] {
+            auto const lock = std::lock_guard{mutex};
+            return lateness.size() >= 20;
+        }));
+    }
+
+    auto const lock = std::lock_guard{mutex};
+    for (auto const late : lateness) {
+        ASSERT(late >= Clock::duration{0});
+    }
+}
+
+TEST(timer_thread_missed_ticks)
+{
+    using zzz::TimerThread;
+
+    // The 5 periods missed are made up for at once, before the deadlines skip would
+    // wait for.
+    auto const catch_up = overrun(TimerThread::MissedTicks::catch_up);
+    ASSERT(catch_up.starts.size() >= 6);
+    ASSERT(catch_up.starts[1] >= catch_up.slow_end);
+    ASSERT(catch_up.starts[5] < catch_up.slow_end + 40ms);
+
+    // The next call is at the next deadline after the slow one returned, the ones
+    // after it a period apart.
+    auto const skip = overrun(TimerThread::MissedTicks::skip);
+    ASSERT(skip.starts.size() >= 6);
+    ASSERT(skip.starts[1] >= skip.slow_end);
+    ASSERT(skip.starts[5] >= skip.slow_end + 40ms);
+
+    // The next call is a period after the slow one returned.
+    auto const delay = overrun(TimerThread::MissedTicks::delay);
+    ASSERT(delay.starts.size() >= 6);
+    ASSERT(delay.starts[1] >= delay.slow_end + 10ms);
+    for (auto i = std::size_t{2}; i < delay.starts.size(); ++i) {
+        ASSERT(delay.starts[i] >= delay.starts[i - 1] + 10ms);
+    }
+}
+
+TEST(timer_thread_zero_period)
+{
+    // A period of zero calls continuously, whatever is done with missed ticks.
+    for (auto const missed_ticks : {zzz::TimerThread::MissedTicks::catch_up,
+                                    zzz::TimerThread::MissedTicks::skip,
+                                    zzz::TimerThread::MissedTicks::delay}) {
+        auto calls = std::atomic<int>{0};
+        auto const options = zzz::TimerThread::Options{.missed_ticks = missed_ticks};
+        auto timer = zzz::TimerThread{0ms, [&] { ++calls; }, options};
+        ASSERT(eventually([&] { return calls.load() >= 100; }));
+    }
+}
+
+TEST(timer_thread_stats)
+{
+    ASSERT(zzz::TimerThread{}.stats().calls == 0);
+    ASSERT(zzz::TimerThread{}.stats().average_lateness() == Clock::duration{0});
+
+    auto const calls = overrun(zzz::TimerThread::MissedTicks::catch_up);
+    auto const& stats = calls.stats;
+    ASSERT(stats.calls == calls.starts.size());
+    ASSERT(stats.overruns >= 1);
+    ASSERT(stats.min_lateness >= Clock::duration{0});
+    ASSERT(stats.min_lateness <= stats.average_lateness());
+    ASSERT(stats.average_lateness() <= stats.max_lateness);
+    // The second deadline is at most a period after the first call started, and its
+    // call only starts once the slow first call returned.
+    ASSERT(stats.max_lateness >= calls.slow_end - calls.starts[0] - 10ms);
+
+    auto const histogram = std::accumulate(stats.lateness_histogram.begin(),
+                                           stats.lateness_histogram.end(),
+                                           std::uint64_t{0});
+    ASSERT(histogram == stats.calls);
+    auto const max_us = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(stats.max_lateness)
+            .count());
+    auto const max_bucket = std::min<std::size_t>(
+        std::bit_width(max_us), zzz::TimerThread::lateness_buckets - 1);
+    ASSERT(stats.lateness_histogram[max_bucket] != 0);
+}
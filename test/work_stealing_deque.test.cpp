@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <zzz/test.hpp>
+#include <zzz/work_stealing_deque.hpp>
+
+TEST(work_stealing_deque)
+{
+    auto x = zzz::WorkStealingDeque<int>{2};
+    ASSERT(x.empty());
+    ASSERT(!x.pop().has_value());
+    ASSERT(!x.steal().has_value());
+
+    // Grows past its initial capacity, the owner pops LIFO, thieves steal FIFO.
+    for (auto i = 0; i < 10; ++i) {
+        x.push(i);
+    }
+    ASSERT(x.size() == 10);
+    ASSERT(x.capacity() >= 10);
+    ASSERT(*x.pop() == 9);
+    ASSERT(*x.steal() == 0);
+    ASSERT(*x.steal() == 1);
+    ASSERT(*x.pop() == 8);
+    ASSERT(x.size() == 6);
+    while (x.pop()) {}
+    ASSERT(x.empty());
+}
+
+TEST(work_stealing_deque_concurrent)
+{
+    constexpr auto count = 100'000;
+    constexpr auto thief_count = 3;
+
+    auto x = zzz::WorkStealingDeque<int>{16};
+    auto seen = std::vector<std::atomic<int>>(count);
+    auto done = std::atomic<bool>{false};
+    {
+        auto thieves = std::vector<std::jthread>{};
+        for (auto i = 0; i < thief_count; ++i) {
+            thieves.emplace_back([&] {
+                while (!done.load()) {
+                    if (auto const value = x.steal()) { ++seen[*value]; }
+                }
+            });
+        }
+        for (auto i = 0; i < count; ++i) {
+            x.push(i);
+            if (i % 3 == 0) {
+                if (auto const value = x.pop()) { ++seen[*value]; }
+            }
+        }
+        while (auto const value = x.pop()) {
+            ++seen[*value];
+        }
+        done.store(true);
+    }
+    // Every value is taken exactly once, by the owner or by a thief.
+    ASSERT(std::ranges::all_of(seen, [](auto const& n) { return n.load() == 1; }));
+}